@@ -35,8 +35,14 @@
 #include <string>
 #include <sstream>
 #include <iostream>
+#include <map>
+#include <atomic>
+#include <unordered_map>
 #include "util.h"
 #include "boost/enable_shared_from_this.hpp"
+#include "boost/weak_ptr.hpp"
+#include "boost/functional/hash.hpp"
+#include "boost/thread/mutex.hpp"
 
 namespace Dyninst {
 
@@ -88,7 +94,10 @@ class ASTVisitor;
 class name : public AST {						\
  public:								\
  typedef boost::shared_ptr<name> Ptr;			\
- static Ptr create(type t) { return Ptr(new name(t)); }			\
+ static Ptr create(type t) {						\
+   static ASTTable<type, name> *table = new ASTTable<type, name>();	\
+   return table->get(t, [&t]() { return new name(t); });		\
+ }									\
  virtual ~name() {};							\
  virtual const std::string format() const {				\
    std::stringstream ret;						\
@@ -115,10 +124,26 @@ class name : public AST {						\
  public:								\
   typedef boost::shared_ptr<name> Ptr;			\
   virtual ~name() {};							\
-  static Ptr create(type t, AST::Ptr a) { return Ptr(new name(t, a)); }	\
-  static Ptr create(type t, AST::Ptr a, AST::Ptr b) { return Ptr(new name(t, a, b)); } \
-  static Ptr create(type t, AST::Ptr a, AST::Ptr b, AST::Ptr c) { return Ptr(new name(t, a, b, c)); } \
-  static Ptr create(type t, Children c) { return Ptr(new name(t, c)); }	\
+  static Ptr create(type t, AST::Ptr a) { return create(t, Children(1, a)); } \
+  static Ptr create(type t, AST::Ptr a, AST::Ptr b) {			\
+    Children c;								\
+    c.push_back(a);							\
+    c.push_back(b);							\
+    return create(t, c);						\
+  }									\
+  static Ptr create(type t, AST::Ptr a, AST::Ptr b, AST::Ptr c) {	\
+    Children k;								\
+    k.push_back(a);							\
+    k.push_back(b);							\
+    k.push_back(c);							\
+    return create(t, k);						\
+  }									\
+  static Ptr create(type t, Children c) {				\
+    static ASTTable<ASTInternalKey<type>, name> *table =		\
+      new ASTTable<ASTInternalKey<type>, name>();			\
+    return table->get(ASTInternalKey<type>(t, c),			\
+                      [&t, &c]() { return new name(t, c); });		\
+  }									\
   virtual const std::string format() const {				\
     std::stringstream ret;						\
     ret << t_ << "(";                                                   \
@@ -137,17 +162,8 @@ class name : public AST {						\
   }									\
   const type &val() const { return t_; }				\
   void setChild(int i, AST::Ptr a) { kids_[i] = a; };			\
+  virtual AST::Ptr rebuild(const Children &kids) { return create(t_, kids); } \
  private:								\
- name(type t, AST::Ptr a) : t_(t) { kids_.push_back(a); };		\
- name(type t, AST::Ptr a, AST::Ptr b) : t_(t) {				\
-    kids_.push_back(a);							\
-    kids_.push_back(b);							\
-  };									\
- name(type t, AST::Ptr a, AST::Ptr b, AST::Ptr c) : t_(t) {		\
-    kids_.push_back(a);							\
-    kids_.push_back(b);							\
-    kids_.push_back(c);							\
-  };									\
  name(type t, Children kids) : t_(t), kids_(kids) {};			\
   virtual bool isStrictEqual(const AST &rhs) const {			\
     const name &other(dynamic_cast<const name&>(rhs));                  \
@@ -187,10 +203,12 @@ class COMMON_EXPORT AST : public boost::enable_shared_from_this<AST> {
   typedef boost::shared_ptr<AST> Ptr;
   typedef std::vector<AST::Ptr> Children;      
 
-  AST() {};
+  AST() : simplified_(0) {};
   virtual ~AST() {};
   
   bool operator==(const AST &rhs) const {
+    // shared nodes are equal without looking further
+    if (this == &rhs) return true;
     // make sure rhs and this have the same type
     return((typeid(*this) == typeid(rhs)) && isStrictEqual(rhs));
   }
@@ -210,10 +228,14 @@ class COMMON_EXPORT AST : public boost::enable_shared_from_this<AST> {
   virtual const std::string format() const = 0;
 
   // Substitutes every occurrence of a with b in
-  // AST in. Returns a new AST. 
+  // AST in. Returns a new AST; in is not modified.
 
   static AST::Ptr substitute(AST::Ptr in, AST::Ptr a, AST::Ptr b); 
 
+  // Returns the node of this type and value with children kids.
+  // Leaves have no children and return themselves.
+  virtual Ptr rebuild(const Children &) { return ptr(); }
+
   // breaks execution if the tree has a cycle. visited should be an empty map.
   static void hasCycle(AST::Ptr in,std::map<AST::Ptr, int> &visited);
   
@@ -224,12 +246,119 @@ class COMMON_EXPORT AST : public boost::enable_shared_from_this<AST> {
 
   Ptr ptr() { return shared_from_this(); }
 
+  // Nodes are shared between every expression that contains them (see
+  // ASTTable below), so changing a child in place changes all of those
+  // expressions. Use rebuild() instead unless the node is known to be
+  // unshared.
   virtual void setChild(int, AST::Ptr) {
     assert(0);
   };
 
+  // Simplification passes that are known to leave this node unchanged.
+  // A pass that does not depend on where the expression is used may
+  // record its fixpoints here and skip them the next time it meets them.
+  typedef enum {
+    S_Boolean = 0x1 } SimplifyPass;
+
+  bool simplified(SimplifyPass p) const { return (simplified_ & p) != 0; }
+  void setSimplified(SimplifyPass p) { simplified_ |= p; }
+
  protected:
   virtual bool isStrictEqual(const AST &rhs) const = 0;
+
+ private:
+  std::atomic<unsigned> simplified_;
+};
+
+// Hash-consing of AST nodes. create() looks a node up by its value and,
+// for internal nodes, by the identity of its children, and hands back the
+// existing node if there is a live one. Since children are shared in turn,
+// an expression is built as a DAG in which each distinct subexpression is
+// allocated once. Nodes are held weakly; expired entries are swept each
+// time the table has doubled since the last sweep.
+
+// Equality used for sharing; must be at least as strict as operator==
+// for anything observable through the node.
+template <class T>
+struct ASTSame {
+  bool operator()(const T &a, const T &b) const { return a == b; }
+};
+
+template <class T>
+struct ASTHash {
+  size_t operator()(const T &t) const { return boost::hash<T>()(t); }
+};
+
+template <class T>
+struct ASTInternalKey {
+  ASTInternalKey(const T &v, const AST::Children &c) : val(v) {
+    for (unsigned i = 0; i < c.size(); ++i)
+      kids.push_back(c[i].get());
+  }
+  T val;
+  std::vector<AST *> kids;
+};
+
+template <class T>
+struct ASTSame<ASTInternalKey<T> > {
+  bool operator()(const ASTInternalKey<T> &a, const ASTInternalKey<T> &b) const {
+    return a.kids == b.kids && ASTSame<T>()(a.val, b.val);
+  }
+};
+
+template <class T>
+struct ASTHash<ASTInternalKey<T> > {
+  size_t operator()(const ASTInternalKey<T> &k) const {
+    size_t h = ASTHash<T>()(k.val);
+    for (unsigned i = 0; i < k.kids.size(); ++i)
+      boost::hash_combine(h, k.kids[i]);
+    return h;
+  }
+};
+
+template <class Key, class Node>
+class ASTTable {
+ public:
+  typedef boost::shared_ptr<Node> Ptr;
+
+  ASTTable() : sweep_(MIN_SWEEP) {}
+
+  template <class Make>
+  Ptr get(const Key &k, Make make) {
+    boost::mutex::scoped_lock l(lock_);
+    typename Map::iterator i = nodes_.find(k);
+    if (i != nodes_.end()) {
+      Ptr p = i->second.lock();
+      if (p) return p;
+      nodes_.erase(i);
+    }
+    Ptr p(make());
+    nodes_.insert(std::make_pair(k, boost::weak_ptr<Node>(p)));
+    if (nodes_.size() >= sweep_) sweep();
+    return p;
+  }
+
+ private:
+  static const size_t MIN_SWEEP = 1024;
+
+  void sweep() {
+    typename Map::iterator i = nodes_.begin();
+    while (i != nodes_.end()) {
+      if (i->second.expired())
+        i = nodes_.erase(i);
+      else
+        ++i;
+    }
+    size_t live = nodes_.size();
+    sweep_ = 2 * live > MIN_SWEEP ? 2 * live : MIN_SWEEP;
+  }
+
+  typedef std::unordered_map<Key, boost::weak_ptr<Node>,
+                             ASTHash<Key>, ASTSame<Key> > Map;
+
+  boost::mutex lock_;
+  Map nodes_;
+  size_t sweep_;
 };
 
  class COMMON_EXPORT ASTVisitor {
@@ -38,6 +38,7 @@
 #include <assert.h>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace Dyninst
 {
@@ -116,6 +117,9 @@ namespace Dyninst
         int getDwarfEnc() const;
 
         static MachRegister getArchReg(unsigned int regNum, Dyninst::Architecture arch);
+        // Appends every register of arch that is its own base register, in ascending
+        // encoding order (general purpose registers first, system registers last).
+        static void getBaseRegisters(Dyninst::Architecture arch, std::vector<MachRegister> &regs);
    };
 
    /**
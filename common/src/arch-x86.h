@@ -883,6 +883,8 @@ class ia32_instruction
   friend unsigned int ia32_decode_operands (const ia32_prefixes& pref, const ia32_entry& gotit, 
                                             const unsigned char* addr, ia32_instruction& instruct,
                                             ia32_memacc *mac);
+  friend unsigned int ia32_measure_operands(const ia32_prefixes& pref, const ia32_entry& gotit,
+                                            const unsigned char* addr, ia32_instruction& instruct);
   friend ia32_instruction& ia32_decode_FP(const ia32_prefixes& pref, const unsigned char* addr,
                                           ia32_instruction& instruct);
   friend unsigned int ia32_emulate_old_type(ia32_instruction& instruct);
@@ -938,6 +940,9 @@ class ia32_instruction
 #define IA32_DECODE_JMPS	    (1<<3)
 #define IA32_DECODE_MEMACCESS	(1<<4)
 #define IA32_DECODE_CONDITION 	(1<<5)
+/* Only measure the operands: the size and the operand byte locations
+ * are filled in, but no memory access is decoded */
+#define IA32_DECODE_LENGTH	(1<<6)
 
 #define IA32_FULL_DECODER (IA32_DECODE_PREFIXES \
         | IA32_DECODE_MNEMONICS \
@@ -0,0 +1,168 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(WORK_STEALING_POOL_H_)
+#define WORK_STEALING_POOL_H_
+
+#include <deque>
+#include <vector>
+#include <atomic>
+#include <assert.h>
+
+#include <boost/function.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+
+/*
+ * A fixed set of worker threads that each own a deque of work items.
+ * Items are dealt round-robin to the workers when the pool is started,
+ * so that every worker makes progress through the items in roughly
+ * the order they were supplied. A worker takes items from the front
+ * of its own deque; once that is empty it steals from the back of the
+ * other workers' deques, i.e. the items that would otherwise be
+ * processed last. Pools whose items must be processed close to the
+ * order supplied (e.g. because a task waits for the item's turn) steal
+ * from the front instead.
+ *
+ * The pool does not allow new items to be added once started; callers
+ * that need further work start the pool again after join().
+ */
+template <typename T>
+class WorkStealingPool {
+ public:
+    typedef boost::function<void (T &)> task_t;
+
+ private:
+    struct worker_queue {
+        boost::mutex lock;
+        std::deque<T> items;
+    };
+
+    std::vector<worker_queue *> queues;
+    std::vector<boost::thread *> threads;
+    task_t task;
+    std::atomic<bool> cancelled;
+    bool steal_front;
+
+    bool take(unsigned self, T & item)
+    {
+        {
+            worker_queue & mine = *queues[self];
+            boost::mutex::scoped_lock l(mine.lock);
+            if(!mine.items.empty()) {
+                item = mine.items.front();
+                mine.items.pop_front();
+                return true;
+            }
+        }
+        for(unsigned i = 1; i < queues.size(); ++i) {
+            worker_queue & victim = *queues[(self + i) % queues.size()];
+            boost::mutex::scoped_lock l(victim.lock);
+            if(victim.items.empty())
+                continue;
+            if(steal_front) {
+                item = victim.items.front();
+                victim.items.pop_front();
+            } else {
+                item = victim.items.back();
+                victim.items.pop_back();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void work(unsigned self)
+    {
+        T item;
+        while(!cancelled && take(self, item))
+            task(item);
+    }
+
+ public:
+    WorkStealingPool(unsigned nthreads, bool in_order = false) :
+        cancelled(false),
+        steal_front(in_order)
+    {
+        if(!nthreads)
+            nthreads = 1;
+        for(unsigned i = 0; i < nthreads; ++i)
+            queues.push_back(new worker_queue());
+    }
+
+    ~WorkStealingPool()
+    {
+        cancel();
+        join();
+        for(unsigned i = 0; i < queues.size(); ++i)
+            delete queues[i];
+    }
+
+    unsigned size() const { return queues.size(); }
+
+    /* Deal out items and start the workers; returns immediately */
+    void start(const std::vector<T> & items, task_t t)
+    {
+        assert(threads.empty());
+        task = t;
+        cancelled = false;
+        for(unsigned i = 0; i < items.size(); ++i)
+            queues[i % queues.size()]->items.push_back(items[i]);
+        for(unsigned i = 0; i < queues.size(); ++i)
+            threads.push_back(new boost::thread(
+                &WorkStealingPool::work, this, i));
+    }
+
+    /* Workers finish their current item and then stop */
+    void cancel()
+    {
+        cancelled = true;
+    }
+
+    void join()
+    {
+        for(unsigned i = 0; i < threads.size(); ++i) {
+            threads[i]->join();
+            delete threads[i];
+        }
+        threads.clear();
+        for(unsigned i = 0; i < queues.size(); ++i)
+            queues[i]->items.clear();
+    }
+
+    /* Convenience: process all of items and wait for completion */
+    void run(const std::vector<T> & items, task_t t)
+    {
+        start(items, t);
+        join();
+    }
+};
+
+#endif
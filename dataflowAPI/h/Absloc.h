@@ -166,6 +166,26 @@ class Absloc {
     return !(*this == rhs);
   }
 
+  friend size_t hash_value(const Absloc &a) {
+    size_t h = a.type_;
+    switch(a.type_) {
+    case Register:
+      boost::hash_combine(h, a.reg_.val());
+      break;
+    case Stack:
+      boost::hash_combine(h, a.off_);
+      boost::hash_combine(h, a.region_);
+      boost::hash_combine(h, a.func_);
+      break;
+    case Heap:
+      boost::hash_combine(h, a.addr_);
+      break;
+    default:
+      break;
+    }
+    return h;
+  }
+
   DATAFLOW_EXPORT static char typeToChar(const Type t) {
     switch(t) {
     case Register:
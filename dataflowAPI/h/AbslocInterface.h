@@ -39,6 +39,11 @@
 #include "Absloc.h"
 #include "util.h"
 
+#include <list>
+#include <set>
+#include <utility>
+#include <boost/thread/mutex.hpp>
+
 class int_function;
 class BPatch_function;
 
@@ -120,9 +125,93 @@ class AbsRegionConverter {
   bool stackAnalysisEnabled_;
 };
 
+/*
+ * Per-CodeObject cache of converted instructions, shared by every
+ * AssignmentConverter that has caching enabled. Entries are keyed by
+ * address, function and whether stack analysis was used, and are
+ * checked against the block they were converted in, so instructions in
+ * blocks that have since been split are converted again. The CodeObject
+ * drops a function's entries when its blocks or edges change, and
+ * freeing a function's stack height annotations drops them too, since
+ * conversions with stack analysis were made from them. The cache
+ * is bounded by the total number of assignments held; the least recently
+ * used instructions are evicted first. All methods are thread-safe.
+ */
+class AssignmentCache {
+ public:
+  typedef std::vector<Assignment::Ptr> AssignmentVec;
+
+  struct Stats {
+    Stats() : hits(0), misses(0), evictions(0), size(0) {}
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    size_t size;        // assignments held
+  };
+
+  static const size_t DEFAULT_LIMIT = 1 << 18;
+
+  DATAFLOW_EXPORT AssignmentCache(size_t max_assigns = DEFAULT_LIMIT);
+  DATAFLOW_EXPORT ~AssignmentCache();
+
+  DATAFLOW_EXPORT bool get(Address addr, ParseAPI::Function *func,
+                           ParseAPI::Block *block,
+                           AssignmentVec &assignments,
+                           bool stack = false);
+  DATAFLOW_EXPORT void put(Address addr, ParseAPI::Function *func,
+                           ParseAPI::Block *block,
+                           const AssignmentVec &assignments,
+                           bool stack = false);
+
+  // Drop the instructions converted in a block that is about to be
+  // destroyed, or in a function that is destroyed or whose CFG changed
+  DATAFLOW_EXPORT void remove(ParseAPI::Block *block);
+  DATAFLOW_EXPORT void remove(ParseAPI::Function *func);
+  DATAFLOW_EXPORT void clear();
+
+  DATAFLOW_EXPORT void set_limit(size_t max_assigns);
+  size_t limit() const { return _max; }
+
+  DATAFLOW_EXPORT Stats stats();
+  DATAFLOW_EXPORT void resetStats();
+
+ private:
+  struct key {
+    key(Address a, ParseAPI::Function *f, bool s) : addr(a), func(f), stack(s) {}
+    Address addr;
+    ParseAPI::Function *func;
+    bool stack;
+    bool operator<(const key &rhs) const {
+      if (addr != rhs.addr) return addr < rhs.addr;
+      if (func != rhs.func) return func < rhs.func;
+      return stack < rhs.stack;
+    }
+  };
+  struct entry {
+    ParseAPI::Block *block;
+    AssignmentVec assigns;
+    std::list<key>::iterator pos;
+  };
+  typedef std::map<key, entry> EntryMap;
+
+  void erase(EntryMap::iterator eit);
+  void evict();
+
+  boost::mutex _lock;
+  EntryMap _entries;
+  std::map<ParseAPI::Function *, size_t> _funcEntries;  // entries per function
+  std::list<key> _lru;    // most recently used first
+  size_t _size;               // assignments held
+  size_t _max;
+  size_t _hits;
+  size_t _misses;
+  size_t _evictions;
+};
+
 class AssignmentConverter {
  public:  
- DATAFLOW_EXPORT AssignmentConverter(bool cache, bool stack) : cacheEnabled_(cache), aConverter(false, stack) {};
+ DATAFLOW_EXPORT AssignmentConverter(bool cache, bool stack) :
+  cacheEnabled_(cache), stackAnalysisEnabled_(stack), aConverter(false, stack) {};
 
   DATAFLOW_EXPORT void convert(InstructionAPI::Instruction::Ptr insn,
                                const Address &addr,
@@ -130,6 +219,10 @@ class AssignmentConverter {
                                ParseAPI::Block *block,
                                std::vector<Assignment::Ptr> &assignments);
 
+  // Forget all converted instructions, e.g. after the CFG changed,
+  // including those of the functions this converter used in the
+  // CodeObject's shared AssignmentCache
+  DATAFLOW_EXPORT void clearCache();
 
  private:
   void handlePushEquivalent(const InstructionAPI::Instruction::Ptr I,
@@ -145,14 +238,22 @@ class AssignmentConverter {
 			   std::vector<AbsRegion> &operands,
 			   std::vector<Assignment::Ptr> &assignments);
 
-  bool cache(ParseAPI::Function *func, Address addr, std::vector<Assignment::Ptr> &assignments);
+  bool cache(ParseAPI::Function *func, ParseAPI::Block *block, Address addr,
+             std::vector<Assignment::Ptr> &assignments);
+  void store(ParseAPI::Function *func, ParseAPI::Block *block, Address addr,
+             const std::vector<Assignment::Ptr> &assignments);
+  AssignmentCache *shared(ParseAPI::Function *func) const;
 
   typedef std::vector<Assignment::Ptr> AssignmentVec;
   typedef std::map<Address, AssignmentVec> AddrCache;
   typedef std::map<ParseAPI::Function *, AddrCache> FuncCache;
 
   FuncCache cache_;
+  // Functions whose conversions this converter looked up in or added to
+  // a shared cache, for clearCache
+  std::set<std::pair<AssignmentCache *, ParseAPI::Function *> > sharedFuncs_;
   bool cacheEnabled_;
+  bool stackAnalysisEnabled_;
 
   AbsRegionConverter aConverter;
 };
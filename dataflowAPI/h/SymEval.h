@@ -132,6 +132,13 @@ friend std::ostream& operator<<(std::ostream& stream, const Constant& c)
     stream << c.format();
     return stream;
 }
+friend size_t hash_value(const Constant &c)
+{
+    size_t h = 0;
+    boost::hash_combine(h, c.val);
+    boost::hash_combine(h, c.size);
+    return h;
+}
   
    uint64_t val;
    size_t size;
@@ -293,6 +300,12 @@ DATAFLOW_EXPORT const std::string format() const {
         stream << c.format();
         return stream;
     }
+    friend size_t hash_value(const ROSEOperation &c)
+    {
+        size_t h = c.op;
+        boost::hash_combine(h, c.size);
+        return h;
+    }
 
 Op op;
 size_t size;
@@ -315,7 +328,36 @@ namespace DataflowAPI {
 
 // compare assignment shared pointers by value.
 typedef std::map<Assignment::Ptr, AST::Ptr, AssignmentPtrValueComp> Result_t;
-    
+
+};
+
+// AbsRegion equality ignores the size and the generating expression,
+// which still show up in the expressions built from a variable, so
+// only share variables that agree on those too.
+template <>
+struct ASTSame<DataflowAPI::Variable> {
+  bool operator()(const DataflowAPI::Variable &a,
+                  const DataflowAPI::Variable &b) const {
+    return a == b &&
+      a.reg.size() == b.reg.size() &&
+      a.reg.generator() == b.reg.generator();
+  }
+};
+
+template <>
+struct ASTHash<DataflowAPI::Variable> {
+  size_t operator()(const DataflowAPI::Variable &v) const {
+    size_t h = hash_value(v.reg.absloc());
+    boost::hash_combine(h, v.reg.type());
+    boost::hash_combine(h, v.reg.size());
+    boost::hash_combine(h, v.reg.generator().get());
+    boost::hash_combine(h, v.addr);
+    return h;
+  }
+};
+
+namespace DataflowAPI {
+
 DEF_AST_LEAF_TYPE(BottomAST, bool);
 DEF_AST_LEAF_TYPE(ConstantAST, Constant);
 DEF_AST_LEAF_TYPE(VariableAST, Variable);
@@ -42,6 +42,9 @@
 #include "ABI.h"
 #include <map>
 #include <set>
+#include <vector>
+#include <utility>
+#include <boost/shared_ptr.hpp>
 
 
 using namespace Dyninst;
@@ -65,20 +68,52 @@ class DATAFLOW_EXPORT LivenessAnalyzer{
 	bool updateBlockLivenessInfo(ParseAPI::Block *block, bitArray &allRegsDefined);
 	
 	ReadWriteInfo calcRWSets(Instruction::Ptr curInsn, ParseAPI::Block* blk, Address a);
+	void calcRWSetsFromRegisters(Instruction::Ptr curInsn, ReadWriteInfo &rw);
+	void setRegister(MachRegister cur, bitArray &bits);
 
 	void* getPtrToInstruction(ParseAPI::Block *block, Address addr) const;	
 	bool isExitBlock(ParseAPI::Block *block);
 	bool isMMX(MachRegister machReg);
 	MachRegister changeIfMMX(MachRegister machReg);
+	void setMaskArch(Architecture arch);
 	int width;
 	ABI* abi;
 
+	// ABI index of each RegisterMask bit of maskArch, or -1; and the bits
+	// whose writes are also reads (the MMX registers, which alias the x87 stack).
+	Architecture maskArch;
+	std::vector<int> maskIndex;
+	RegisterMask readOnWrite;
+
+	// Results of analyze(CodeObject*), shared read-only between copies;
+	// functions passed to clean(func) since then are answered the old way.
+	struct BatchInfo;
+	boost::shared_ptr<BatchInfo> batch;
+	std::set<ParseAPI::Function*> batchStale;
+
+	void batchSummarize(BatchInfo *b, std::pair<unsigned, unsigned> &range);
+	void batchSolve(BatchInfo *b, unsigned &func);
+
 public:
 	typedef enum {Before, After} Type;
 	typedef enum {Invalid_Location} ErrorType;
 	LivenessAnalyzer(int w);
 	void analyze(ParseAPI::Function *func);
 
+	// Compute liveness for every function of co at once, using threads
+	// worker threads (co->parseThreads() if 0). Results are kept in flat
+	// per-instruction arrays, so later queries on these functions do no
+	// decoding or dataflow work; the CFG must not change while they are used.
+	// Such a query is not constant time: it looks the function and block
+	// up in hash maps, binary searches the function's blocks if the block
+	// is shared with a function analyzed before it, and binary searches
+	// the block's instructions for a location inside the block.
+	void analyze(ParseAPI::CodeObject *co, unsigned int threads = 0);
+
+	// Answer only from the results of analyze(CodeObject*); returns false
+	// if they do not cover loc, where query() would analyze loc.func.
+	bool batchQuery(const ParseAPI::Location &loc, Type type, bitArray &bitarray);
+
 	template <class OutputIterator>
 	bool query(ParseAPI::Location loc, Type type, OutputIterator outIter){
 		bitArray liveRegs;
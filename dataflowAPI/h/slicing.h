@@ -72,6 +72,7 @@ typedef boost::shared_ptr<Graph> GraphPtr;
  typedef boost::shared_ptr<InstructionAPI::Instruction> InstructionPtr;
 
  class Slicer;
+ class SlicingSession;
 
 // Used in temp slicer; should probably
 // replace OperationNodes when we fix up
@@ -142,6 +143,13 @@ class Slicer {
 	 ParseAPI::Function *func,
 	 bool cache = true,
 	 bool stackAnalysis = true);
+
+  // Slice from a within a session: decoded blocks and converted
+  // assignments come from, and are left in, the session's caches
+  DATAFLOW_EXPORT Slicer(AssignmentPtr a,
+	 ParseAPI::Block *block,
+	 ParseAPI::Function *func,
+	 SlicingSession &session);
     
   DATAFLOW_EXPORT static bool isWidenNode(Node::Ptr n);
 
@@ -308,6 +316,7 @@ class Slicer {
   DATAFLOW_EXPORT GraphPtr backwardSlice(Predicates &predicates);
 
  private:
+  friend class SlicingSession;
 
   typedef enum {
     forward,
@@ -720,6 +729,7 @@ private:
   std::set<Address> addrSet;
 
   AssignmentConverter converter;
+  SlicingSession *session_;
 
   SliceNode::Ptr widen_;
  public: 
@@ -729,6 +739,51 @@ private:
   std::set<ParseAPI::Edge*> visitedEdges;
 };
 
+/*
+ * State shared by a series of slices in one function: the decoded
+ * instructions of each block visited and the assignments each
+ * instruction converts to, for the function and any callees the
+ * slices follow. A fresh Slicer is still made per slice, as the
+ * DefCache and visited-edge maps depend on the slicing criterion and
+ * predicates and are only valid for the slice that built them.
+ *
+ * The session watches its function's CodeObject and discards its
+ * caches before the next slice once any block, edge or function there
+ * is split, added, removed or modified. Only one slice may run in a
+ * session at a time, and the CodeObject must outlive the session.
+ */
+class DATAFLOW_EXPORT SlicingSession {
+ public:
+  SlicingSession(ParseAPI::Function *func, bool stackAnalysis = true);
+  ~SlicingSession();
+
+  ParseAPI::Function *func() const { return func_; }
+
+  GraphPtr forwardSlice(AssignmentPtr a, ParseAPI::Block *block,
+                        Slicer::Predicates &predicates);
+  GraphPtr backwardSlice(AssignmentPtr a, ParseAPI::Block *block,
+                         Slicer::Predicates &predicates);
+
+  // Drop all cached state now
+  void invalidate();
+
+ private:
+  friend class Slicer;
+  class Watcher;
+
+  SlicingSession(const SlicingSession &);
+  SlicingSession &operator=(const SlicingSession &);
+
+  // Called by Slicer before each slice
+  void sync();
+
+  ParseAPI::Function *func_;
+  Slicer::InsnCache insnCache_;
+  AssignmentConverter converter_;
+  Watcher *watcher_;
+  bool stale_;
+};
+
 }
 
 #endif
@@ -65,6 +65,7 @@ namespace Dyninst {
       class Function;
       class Block;
       class Edge;
+      class CodeObject;
    };
    namespace InstructionAPI {
       class Instruction;
@@ -172,6 +173,12 @@ public:
          return type_ == rhs.type_ && height_ == rhs.height_;
       }
 
+      friend size_t hash_value(const Height &h) {
+         size_t ret = h.type_;
+         boost::hash_combine(ret, h.height_);
+         return ret;
+      }
+
       bool operator!=(const Height &rhs) const {
          return !(*this == rhs);
       }
@@ -637,6 +644,53 @@ private:
    ExpressionPtr thePC;
 };
 
+/*
+ * Stack analysis of a whole CodeObject. analyze() summarizes every
+ * function's effect on registers and its caller's stack frame, bottom-up
+ * over the call graph so that each function is analyzed with the
+ * summaries of its callees; mutually recursive functions are iterated to
+ * a fixed point together. Independent functions are analyzed in parallel.
+ * Each function's stack heights are then left attached to it, so later
+ * StackAnalysis(func).findSP()/findFP() calls are lookups.
+ *
+ * The summaries can be saved next to a persisted CFG and loaded for a
+ * later run on the same binary, in which case analyze() only recomputes
+ * the heights. They are keyed by function entry address, and analyze()
+ * reuses one only if the code of the function and of everything it calls
+ * is unchanged.
+ */
+class DATAFLOW_EXPORT StackSummaries {
+public:
+   StackSummaries() : word_size(0) {}
+
+   // Use threads worker threads (co->parseThreads() if 0). The CFG of
+   // co is frozen first. Annotations are kept in one table for the whole
+   // process, so nothing else may add or remove annotations on any
+   // object, in this or another CodeObject, while this runs.
+   void analyze(ParseAPI::CodeObject *co, unsigned int threads = 0);
+
+   // False if the function at entry was not analyzed or could not be
+   // summarized (e.g. it never returns)
+   bool getSummary(Address entry, StackAnalysis::TransferSet &summary) const;
+   const std::map<Address, StackAnalysis::TransferSet> &summaries() const {
+      return funcSummaries;
+   }
+
+   bool save(const std::string &path) const;
+   // Replaces the current contents; false and empty if path is missing,
+   // corrupt or from an incompatible version
+   bool load(const std::string &path);
+   void clear();
+
+private:
+   int word_size;
+   std::map<Address, StackAnalysis::TransferSet> funcSummaries;
+   // Functions analyzed, with or without a summary
+   std::set<Address> analyzed;
+   // Hash of the code of each function analyzed
+   std::map<Address, uint64_t> codeHashes;
+};
+
 } // namespace Dyninst
 
 
@@ -66,10 +66,14 @@ class StackVisitor : public ASTVisitor {
     DATAFLOW_EXPORT virtual ~StackVisitor() {};
 
   private:
+  AST::Ptr simplify(RoseAST *);
+
   Address addr_;
   ParseAPI::Function *func_;
   StackAnalysis::Height stack_;
   StackAnalysis::Height frame_;
+  // shared subexpressions are simplified once
+  std::map<AST *, AST::Ptr> done_;
 };
 
   // Simplify boolean expressions for PPC
@@ -93,6 +97,9 @@ class BooleanVisitor : public ASTVisitor {
     DATAFLOW_EXPORT virtual ~BooleanVisitor() {};
     
   private:
+    AST::Ptr simplify(RoseAST *);
+
+    std::map<AST *, AST::Ptr> done_;
 };
 
 };
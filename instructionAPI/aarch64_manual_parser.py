@@ -369,14 +369,14 @@ class OpTable:
         print len(self.insnArray)
         print '*** instruction table ***'
 
+        operandLines = list()
+        entryLines = list()
+        operandIndex = 0
         for i in range(0, len(self.insnArray)):
             instruction = self.insnArray[i]
+            factories = list()
 
-            if len(self.operandsArray[i]) == 0:
-                operands = 'operandSpec()'
-            else:
-                operands = 'list_of'
-
+            if len(self.operandsArray[i]) != 0:
                 # recognize FP and SIMD
                 if instruction in fp_insn_set:
                     if self.isSIMD(instruction) == False:
@@ -391,28 +391,36 @@ class OpTable:
                         if self.getRegWidth(instruction) != 128:
                             print '[WARN] unknown width'
 
-                for index, operand in enumerate(self.operandsArray[i]):
-                    # this is solution to the compiler bug
-                    # if OPRimm<x, y> appears in the first place of the list
-                    if len(operand) != 1 and index == 0:
-                        operands += '( (operandFactory) fn('
-                    else:
-                        operands += '( fn('
-
+                for operand in self.operandsArray[i]:
                     if len(operand) != 1:
-                        operands += 'OPR'+operand[0]+'<'+ str(operand[1][0])+' COMMA ' + str(operand[1][1])+'>'
+                        factories.append('fn(OPR'+operand[0]+'<'+ str(operand[1][0])+' COMMA ' + str(operand[1][1])+'>)')
                     else:
                         curOperandName = operand[0]
                         if curOperandName.startswith('set'):
-                            operands += curOperandName
+                            factories.append('fn('+curOperandName+')')
                         else:
-                            operands += 'OPR'+ curOperandName
-
-                    operands += ') )'
+                            factories.append('fn(OPR'+curOperandName+')')
 
-            #print '\tmain_insn_table.push_back(aarch64_insn_entry(aarch64_op_'+ self.insnArray[i]+', \t\"'+ self.insnArray[i].split('_')[0]+'\",\t'+ operands +' ));'
-            print '\tmain_insn_table.push_back(aarch64_insn_entry(aarch64_op_'+ self.insnArray[i]+', \t\"'+ self.insnArray[i].split('_')[0]+'\",\t'+ operands +', ' \
-                + str(self.encodingsArray[i]) + ', ' + str(self.masksArray[i]) + ') );'
+            # the operands of an instruction are a run of operand_table
+            if len(factories) == 0:
+                firstOperand = 0
+            else:
+                firstOperand = operandIndex
+                operandLines.append('\t/* %4d */ ' % operandIndex + ', '.join(factories) + ',\t// ' + instruction)
+                operandIndex += len(factories)
+
+            entryLines.append('\t{aarch64_op_'+ instruction+', \t\"'+ instruction.split('_')[0]+'\",\t'+ str(firstOperand) +', ' \
+                + str(len(factories)) + ', ' + str(self.encodingsArray[i]) + ', ' + str(self.masksArray[i]) + '},')
+
+        print 'const operandFactory aarch64_insn_entry::operand_table[] = {'
+        for line in operandLines:
+            print line
+        print '};'
+        print
+        print 'const aarch64_insn_entry aarch64_insn_entry::main_insn_table[] = {'
+        for line in entryLines:
+            print line
+        print '};'
 
 ##################
 # a helper function
@@ -428,32 +436,37 @@ def clapseMask(encoding, curMask):
     return ret
 
 ####################################
-# generate the c++ code
-# which builds the decoding table
+# record the nodes of the decoding table;
+# printDecoderNodes generates the c++ code
 ####################################
-def printDecodertable(entryToPlace, curMask=0, entryList=list(), index=-1 ):
-    entries = 'map_list_of'
-    if len(entryList) == 0:
-        entries = 'branchMap()'
-    else:
-        for ent in entryList:
-            entries += '('+str(ent[0])+','+str(ent[1])+')'
+decoderNodes = dict()
 
-    print '\tmain_decoder_table['+str(entryToPlace)+']=aarch64_mask_entry('+str(hex(curMask))+', '+entries+','+str(index)+');'
+def printDecodertable(entryToPlace, curMask=0, entryList=list(), index=-1 ):
+    decoderNodes[entryToPlace] = (curMask, list(entryList), index)
 
+# the decoder only uses the first of the candidate entries
 def printDecodertable_list(entryToPlace, curMask=0, entryList=list(), index=list() ):
-    entries = 'map_list_of'
-    if len(entryList) == 0:
-        entries = 'branchMap()'
-    else:
-        for ent in entryList:
-            entries += '('+str(ent[0])+','+str(ent[1])+')'
-
-    index_list = str()
-    for i in index:
-        index_list += '('+ str(i) +')'
-
-    print '\tmain_decoder_table['+str(entryToPlace)+']=aarch64_mask_entry('+str(hex(curMask))+', '+entries+', list_of'+ index_list+');'
+    decoderNodes[entryToPlace] = (curMask, list(entryList), index[0])
+
+def printDecoderNodes():
+    print 'const aarch64_mask_entry aarch64_mask_entry::main_decoder_table[] = {'
+    branchLines = list()
+    branchIndex = 0
+    for entry in range(0, max(decoderNodes.keys()) + 1):
+        curMask, entryList, index = decoderNodes.get(entry, (0, list(), 0))
+        entryList.sort()
+        firstBranch = 0
+        if len(entryList) != 0:
+            firstBranch = branchIndex
+            branchLines.append('\t/* %3d */ ' % branchIndex + ' '.join('{%d, %d},' % ent for ent in entryList) + '\t// node %d' % entry)
+            branchIndex += len(entryList)
+        print '\t/* %3d */ {%s, %d, %d, %d},' % (entry, hex(curMask), firstBranch, len(entryList), index)
+    print '};'
+    print
+    print 'const aarch64_decoder_branch aarch64_mask_entry::decoder_branches[] = {'
+    for line in branchLines:
+        print line
+    print '};'
 
 def num1sInMask(x):
     mask = masksArray[x]
@@ -776,7 +789,7 @@ def main():
     ###########################################
     # Decoder table.
     # Generate C++ code to build decoding table.
-    # Basically, the generated stuff is a decision tree, which is represented in a map.
+    # Basically, the generated stuff is a decision tree, which is represented in constant arrays.
     #
     # Each entry stands for a decision node in the decision tree with a few or zero
     #   branches. One branch contains a {Key, Value} pair. Key is used to index. Value is
@@ -795,6 +808,7 @@ def main():
     validInsnIndex = list( range(0, len(opTable.insnArray) ) )
     decodeTable = DecodeTable()
     decodeTable.buildDecodeTable(validInsnIndex, 0 , 0)
+    printDecoderNodes()
 
     ###############################
     # some statistics for debugging
@@ -81,8 +81,13 @@ for name in reg_names:
 	    reg_encodings[name.replace("n_", str(idx) + "_")] = hex(int(cur_encoding, 2))
 	    reg_sizes[name.replace("n_", str(idx) + "_")] = size
 
+# The decoder binary-searches this table; a later register with the same
+# encoding replaces an earlier one
+sys_regs = dict()
 for elem in reg_encodings:
-    print("sysRegMap[" + reg_encodings[elem] + "] = aarch64::" + elem + ";");
+    sys_regs[int(reg_encodings[elem], 16)] = elem
+for encoding in sorted(sys_regs):
+    print("\t{" + hex(encoding) + ", aarch64::i" + sys_regs[encoding] + "},");
 
 print()
 ct = 0
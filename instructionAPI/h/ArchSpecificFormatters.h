@@ -33,10 +33,16 @@
 
 #include <map>
 #include <vector>
+#include <list>
 #include <string>
+#include "dyn_regs.h"
+#include "InstructionCategories.h"
+#include "FormatBuffer.h"
 
 namespace Dyninst {
     namespace InstructionAPI {
+        class Operation;
+        class Operand;
 
         class ArchSpecificFormatter {
         public:
@@ -87,6 +93,18 @@ namespace Dyninst {
             virtual std::string formatBinaryFunc(std::string, std::string, std::string);
             virtual ~x86Formatter() {}
         };
+
+        /// Writes x86 and x86-64 instructions in AT&T or Intel syntax directly into a
+        /// %FormatBuffer, without the intermediate strings of x86Formatter.  Its AT&T
+        /// output is the same as that of Instruction::format(Address).
+        class x86BufferFormatter {
+        public:
+            /// Returns false, having written nothing, if an operand is not an address
+            /// computation of the form base + index * scale + displacement.
+            static bool format(FormatBuffer &out, const Operation &op, const std::list<Operand> &operands,
+                               Architecture arch, InsnCategory category, Address addr,
+                               FormatSyntax syntax, const SymbolLookup *symbols);
+        };
     };
 };
 
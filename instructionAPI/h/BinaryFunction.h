@@ -35,6 +35,7 @@
 #include "Register.h"
 #include "Result.h"
 #include <sstream>
+#include <boost/scoped_array.hpp>
 
 #if defined(_MSC_VER)
 #pragma warning(disable:4251)
@@ -401,9 +402,14 @@ namespace Dyninst
 			}
   
 		private:
+		  bool bindArg(unsigned int index, const Expression::Ptr& arg, Expression* expr, const Result& value);
+		  Result argValue(unsigned int index, const Expression::Ptr& arg) const;
+
 		  Expression::Ptr m_arg1;
 		  Expression::Ptr m_arg2;
 		  funcT::Ptr m_funcPtr;
+		  // Values bound to shared leaf arguments, allocated on the first such bind
+		  boost::scoped_array<Result> m_bound;
       
 		};
 	};
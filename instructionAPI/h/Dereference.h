@@ -75,6 +75,10 @@ namespace Dyninst
       /// indicating how the memory at the address in question is to be interpreted.
       Dereference(Expression::Ptr addr, Result_Type result_type) : Expression(result_type), addressToDereference(addr)
       {
+          // The address is handed out as an effective address and bound
+          // by users, so it may not be a shared leaf
+          if(addressToDereference->isShared())
+              addressToDereference = addressToDereference->unsharedCopy();
       }
       virtual ~Dereference() 
       {
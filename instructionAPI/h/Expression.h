@@ -154,6 +154,16 @@ namespace Dyninst
       /// bound to 0.
       virtual bool bind(Expression* expr, const Result& value);
 
+      /// Register and small immediate leaves created by the decoders are interned: one
+      /// shared, immutable %Expression represents every occurrence of that leaf, so
+      /// identical leaves compare equal by address.  \c setValue, \c clearValue and
+      /// \c bind leave a shared leaf unchanged; a %BinaryFunction keeps the values bound
+      /// to its shared children itself.  Operand::getValue and Instruction::getControlFlowTarget
+      /// return private copies of shared leaves, and the address of a %Dereference is never one.
+      bool isShared() const { return m_shared; }
+      /// Returns an unshared copy of this leaf, or a null pointer for composite expressions.
+      virtual Expression::Ptr unsharedCopy() const;
+
 
       /// \c apply applies a %Visitor to this expression.  %Visitors perform postfix-order
       /// traversal of the ASTs represented by an %Expression, with user-defined actions performed
@@ -168,7 +178,12 @@ namespace Dyninst
       
     protected:
       virtual bool isFlag() const;
+      /// True if \c bind on this %Expression would match \c expr
+      virtual bool bindsTo(Expression* expr) const;
+      /// True if \c child is a shared leaf that \c bind would otherwise match to \c expr
+      static bool sharedBindsTo(const Expression::Ptr& child, Expression* expr);
       Result userSetValue;
+      bool m_shared;
       
     };
     class INSTRUCTION_EXPORT DummyExpr : public Expression
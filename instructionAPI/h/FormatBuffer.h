@@ -0,0 +1,133 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(FORMAT_BUFFER_H)
+#define FORMAT_BUFFER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "dyntypes.h"
+#include "util.h"
+
+namespace Dyninst
+{
+  namespace InstructionAPI
+  {
+    /// The assembly syntaxes that Instruction::format can write into a %FormatBuffer.
+    enum FormatSyntax
+    {
+        attSyntax,      ///< the syntax of Instruction::format(Address)
+        intelSyntax     ///< destination first, unprefixed registers, sized memory operands
+    };
+
+    /// A %SymbolLookup names the addresses that formatted instructions refer to.
+    /// When an %Instruction is formatted at a known address, each operand that
+    /// computes an address from the program counter (branch and call targets,
+    /// and PC-relative memory references) is passed to \c lookup, and is written
+    /// as the returned name rather than as a number.
+    class INSTRUCTION_EXPORT SymbolLookup
+    {
+    public:
+        virtual ~SymbolLookup() {}
+        /// Returns the name of the symbol containing \c addr, setting \c offset to
+        /// the distance of \c addr from its start, or NULL if there is none.  The
+        /// name must remain valid until the formatting call returns.
+        virtual const char* lookup(Address addr, Address& offset) const = 0;
+    };
+
+    /// A %FormatBuffer writes text into a fixed, caller-owned character array.
+    /// Like \c snprintf, it never writes past the end of the array, always leaves
+    /// the text NUL-terminated, and counts the characters the whole text would have
+    /// needed, so that a truncated result can be detected and retried with a larger
+    /// array.  It performs no heap allocation.
+    class INSTRUCTION_EXPORT FormatBuffer
+    {
+    public:
+        FormatBuffer(char* buf, size_t size) : m_buf(buf), m_size(size), m_len(0)
+        {
+            if(m_size) m_buf[0] = '\0';
+        }
+
+        void append(char c)
+        {
+            if(m_len + 1 < m_size)
+            {
+                m_buf[m_len] = c;
+                m_buf[m_len + 1] = '\0';
+            }
+            ++m_len;
+        }
+        void append(const char* s, size_t n)
+        {
+            if(m_len + 1 < m_size)
+            {
+                size_t room = m_size - m_len - 1;
+                size_t copied = n < room ? n : room;
+                memcpy(m_buf + m_len, s, copied);
+                m_buf[m_len + copied] = '\0';
+            }
+            m_len += n;
+        }
+        void append(const char* s) { append(s, strlen(s)); }
+        /// Appends \c val in lowercase hexadecimal, without a prefix.
+        void appendHex(uint64_t val)
+        {
+            char digits[16];
+            int n = 0;
+            do
+            {
+                digits[n++] = "0123456789abcdef"[val & 0xf];
+                val >>= 4;
+            } while(val);
+            while(n) append(digits[--n]);
+        }
+
+        /// The text written so far; it is cut short if \c truncated is true.
+        const char* c_str() const { return m_size ? m_buf : ""; }
+        /// The length of the full text, including any part that did not fit.
+        size_t length() const { return m_len; }
+        bool truncated() const { return m_len >= m_size; }
+        /// Discard the text, keeping the array.
+        void clear()
+        {
+            m_len = 0;
+            if(m_size) m_buf[0] = '\0';
+        }
+
+    private:
+        char* m_buf;
+        size_t m_size;
+        size_t m_len;
+    };
+  };
+};
+
+#endif //!defined(FORMAT_BUFFER_H)
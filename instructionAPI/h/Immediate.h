@@ -66,6 +66,11 @@ namespace Dyninst
       virtual std::string format(ArchSpecificFormatter *, formatStyle) const;
       virtual std::string format(formatStyle) const;
       static Immediate::Ptr makeImmediate(const Result& val);
+      /// Returns the interned %Immediate for \c val if it is a small integer (see
+      /// Expression::isShared), and a new %Immediate otherwise.  Safe to call from
+      /// multiple threads.
+      static Immediate::Ptr makeShared(const Result& val);
+      virtual Expression::Ptr unsharedCopy() const;
       virtual void apply(Visitor* v);
       
     protected:
@@ -40,6 +40,7 @@
 #include "Operand.h"
 #include "InstructionCategories.h"
 #include "ArchSpecificFormatters.h"
+#include "RegisterMask.h"
 
 #include "util.h"
 
@@ -179,6 +180,24 @@ namespace Dyninst
       /// involved are read but not written, regardless of the effect on the operand.
       INSTRUCTION_EXPORT void getReadSet(std::set<RegisterAST::Ptr>& regsRead) const;
 
+      /// Returns the registers read by the instruction as a %RegisterMask.
+      ///
+      /// The mask holds the same registers as \c getReadSet, folded to their base registers
+      /// (and, on x86, with the \c flags register expanded into the individual flags).  It is
+      /// computed the first time any of the masks is requested and kept with the instruction,
+      /// so analyses that visit an instruction many times do not rebuild register sets.
+      INSTRUCTION_EXPORT const RegisterMask& getReadMask() const;
+
+      /// Returns the registers written by the instruction as a %RegisterMask, in the same form
+      /// as \c getReadMask.
+      INSTRUCTION_EXPORT const RegisterMask& getWriteMask() const;
+
+      /// Returns the registers of the write mask that are only partly written, where the
+      /// bits of the base register outside the written sub-register keep their old value
+      /// (on x86 and x86-64, writes to 8- and 16-bit registers).  A partial write is also a
+      /// read of the base register for the purposes of liveness.
+      INSTRUCTION_EXPORT const RegisterMask& getPartialWriteMask() const;
+
       /// \param candidate Subexpression to search for among the values read by this %Instruction object.
       ///
       /// Returns true if \c candidate is read by this %Instruction.
@@ -251,6 +270,23 @@ namespace Dyninst
       /// diagnostic purposes.
       INSTRUCTION_EXPORT std::string format(Address addr = 0) const;
 
+      /// Writes the instruction as assembly language into \c out, performing no heap
+      /// allocation for x86 and x86-64.  In \c attSyntax the text is that of \c format(addr).
+      /// If \c addr is nonzero and \c symbols is given, branch targets and PC-relative
+      /// memory references are written as the names \c symbols returns for them.
+      ///
+      /// Instructions of other architectures, and the rare x86 operand that is not
+      /// an address computation, are written by way of \c format(addr): in AT&T syntax
+      /// whatever \c syntax asks for, and without \c symbols.  Returns false if so.
+      INSTRUCTION_EXPORT bool format(FormatBuffer& out, Address addr = 0, FormatSyntax syntax = attSyntax,
+                                     const SymbolLookup* symbols = NULL) const;
+
+      /// As above, writing into the \c len bytes at \c buf.  Like \c snprintf, returns the
+      /// length of the whole text; the text was truncated if this is not less than \c len.
+      /// Use the %FormatBuffer overload to learn whether \c syntax and \c symbols were applied.
+      INSTRUCTION_EXPORT size_t format(char* buf, size_t len, Address addr = 0, FormatSyntax syntax = attSyntax,
+                                       const SymbolLookup* symbols = NULL) const;
+
       /// Returns true if this %Instruction object is valid.  Invalid instructions indicate that
       /// an %InstructionDecoder has reached the end of its assigned range, and that decoding should terminate.
       INSTRUCTION_EXPORT bool isValid() const;
@@ -287,6 +323,8 @@ namespace Dyninst
       void addSuccessor(Expression::Ptr e, bool isCall, bool isIndirect, bool isConditional, bool isFallthrough) const;
       void copyRaw(size_t size, const unsigned char* raw);
       Expression::Ptr makeReturnExpression() const;
+      struct RegisterMasks;
+      const RegisterMasks& registerMasks() const;
       mutable std::list<Operand> m_Operands;
       Operation::Ptr m_InsnOp;
       bool m_Valid;
@@ -294,6 +332,8 @@ namespace Dyninst
       unsigned int m_size;
       Architecture arch_decoded_from;
       mutable std::list<CFT> m_Successors;
+      // Set once by registerMasks; always accessed with boost::atomic_load and friends
+      mutable boost::shared_ptr<const RegisterMasks> m_RegisterMasks;
       static int numInsnsAllocated;
       ArchSpecificFormatter *formatter;
     };
@@ -32,6 +32,7 @@
 #define INSTRUCTION_DECODER_H
 
 #include "Instruction.h"
+#include "InstructionValue.h"
 
 #if defined(_MSC_VER)
 #pragma warning(disable:4251)
@@ -72,6 +73,25 @@ namespace Dyninst
       /// a null %Instruction pointer will be returned.  The %Instruction's \c size field will contain
       /// the size of the instruction decoded.
       Instruction::Ptr decode(const unsigned char* buffer);
+      /// Decode the current instruction in this %InstructionDecoder object's buffer into the
+      /// caller-owned \c insn, without allocating.  Returns false at the end of the buffer or if
+      /// no instruction could be decoded.  See InstructionValue for details.
+      bool decode(InstructionValue& insn);
+      /// Decode the instruction at \c buffer into \c insn, as above.
+      bool decode(const unsigned char* buffer, InstructionValue& insn);
+      /// Decode only the length, opcode, category and control flow properties of the current
+      /// instruction into \c insn; operands are left to InstructionValue::expand.  This is
+      /// intended for linear sweeps that only need to step over instructions and find branches.
+      bool decodeControlFlow(InstructionValue& insn);
+      /// Decode the control flow properties of the instruction at \c buffer into \c insn, as above.
+      bool decodeControlFlow(const unsigned char* buffer, InstructionValue& insn);
+      /// Decode every instruction from the current position to the end of the buffer in one pass,
+      /// appending a compact record for each to \c records.  \c base is the address of the current
+      /// position, from which branch targets are computed, and record offsets are relative to it.
+      /// Illegal instructions are recorded as such, as \c decode would return them.  Decoding
+      /// stops early if no instruction can be decoded or one would extend past the end of the
+      /// buffer; the decoder is left positioned there.  Returns the number of records appended.
+      size_t decodeRange(Address base, std::vector<InstructionRecord>& records);
       void doDelayedDecode(const Instruction* insn_to_complete);
       struct INSTRUCTION_EXPORT buffer
       {
@@ -0,0 +1,195 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(INSTRUCTION_VALUE_H)
+#define INSTRUCTION_VALUE_H
+
+#include "Instruction.h"
+
+namespace Dyninst
+{
+  namespace InstructionAPI
+  {
+    /// An %OperandValue describes one operand of an %InstructionValue without
+    /// building an expression tree for it.  Registers are stored as \c MachRegister
+    /// values and memory operands as a base + index * scale + displacement
+    /// address computation.  The target of an indirect branch or call is described
+    /// by a read operand.
+    struct INSTRUCTION_EXPORT OperandValue
+    {
+        enum Kind
+        {
+            none,
+            reg,        ///< \c base is the register
+            imm,        ///< \c value is the immediate
+            mem,        ///< a memory access at \c base + \c index * \c scale + \c value
+            addr,       ///< the address computation of \c mem, without the access (e.g. \c lea)
+            pcrel,      ///< a branch displacement \c value from the end of the instruction
+            other       ///< not representable; see \c InstructionValue::expand
+        };
+
+        unsigned char kind;
+        bool isRead;
+        bool isWritten;
+        bool isImplicit;
+        unsigned char scale;
+        MachRegister base;
+        MachRegister index;
+        int64_t value;
+
+        OperandValue() :
+            kind(none), isRead(false), isWritten(false), isImplicit(false),
+            scale(0), base(InvalidReg), index(InvalidReg), value(0) {}
+    };
+
+    /// An %InstructionValue is a fixed-size, caller-owned record of a decoded instruction.
+    /// It holds a copy of the instruction bytes, the opcode and category, and its operands
+    /// in inline storage; filling one in performs no heap allocation and no reference counting.
+    /// It is produced by the %InstructionDecoder \c decode overloads that take an
+    /// %InstructionValue, and is intended for sweeps over large amounts of code where only
+    /// a few properties of each instruction are examined.
+    ///
+    /// The operands are described for x86, x86-64 and the branches of aarch64.  When an
+    /// operand cannot be described this way (or, on other architectures, not at all),
+    /// \c operandsComplete returns false; \c expand builds the equivalent %Instruction,
+    /// with full expression trees, on request.
+    class INSTRUCTION_EXPORT InstructionValue
+    {
+        friend class InstructionDecoder;
+        friend class InstructionDecoderImpl;
+        friend class InstructionDecoder_x86;
+        friend class InstructionDecoder_aarch64;
+    public:
+        static const unsigned int maxOperands = 5;
+        static const unsigned int maxLength = 16;
+
+        InstructionValue() { clear(Arch_none); }
+
+        /// Returns true if this object holds a decoded instruction.
+        bool isValid() const { return m_size != 0; }
+        /// Returns true if the bytes decoded to an instruction legal for the architecture,
+        /// as Instruction::isLegalInsn does.
+        bool isLegalInsn() const { return m_id != e_No_Entry; }
+
+        Architecture getArch() const { return m_arch; }
+        entryID getID() const { return m_id; }
+        InsnCategory getCategory() const { return m_category; }
+        unsigned int size() const { return m_size; }
+        const unsigned char* ptr() const { return m_raw; }
+        unsigned char rawByte(unsigned int index) const { return index < m_size ? m_raw[index] : 0; }
+
+        unsigned int numOperands() const { return m_numOperands; }
+        const OperandValue& getOperand(unsigned int index) const { return m_operands[index]; }
+        /// False if some operand of the instruction is missing from, or
+        /// \c other in, the operand list.
+        bool operandsComplete() const { return m_complete; }
+
+        /// Returns true if the instruction transfers control to a target encoded
+        /// in the instruction, storing that target in \c target given the
+        /// address \c addr of the instruction.
+        bool getDirectTarget(Address addr, Address& target) const
+        {
+            if(!m_hasTarget) return false;
+            target = addr + m_size + m_targetDisp;
+            return true;
+        }
+        bool isIndirect() const { return m_indirect; }
+        bool isConditional() const { return m_conditional; }
+        /// Returns true if the instruction encodes a displacement from the program
+        /// counter (a branch displacement, or a RIP-relative data displacement), storing
+        /// where it is in the instruction's bytes.  Only filled in for x86 and x86-64.
+        bool getPCRelativeField(unsigned int& offset, unsigned int& size) const
+        {
+            if(!m_pcrelSize) return false;
+            offset = m_pcrelOffset;
+            size = m_pcrelSize;
+            return true;
+        }
+
+        /// Build the %Instruction represented by this value, decoding its operands
+        /// into expression trees.
+        Instruction::Ptr expand() const;
+
+    private:
+        void clear(Architecture arch);
+        bool addOperand(const OperandValue& op);
+
+        unsigned char m_raw[maxLength];
+        unsigned char m_size;
+        unsigned char m_numOperands;
+        bool m_complete;
+        bool m_hasTarget;
+        bool m_indirect;
+        bool m_conditional;
+        unsigned char m_pcrelOffset;
+        unsigned char m_pcrelSize;
+        Architecture m_arch;
+        entryID m_id;
+        InsnCategory m_category;
+        int64_t m_targetDisp;    // relative to the end of the instruction
+        OperandValue m_operands[maxOperands];
+    };
+
+    /// An %InstructionRecord is the compact description of one instruction produced
+    /// by \c InstructionDecoder::decodeRange: where the instruction is, its length,
+    /// opcode and category, and how it transfers control.  Records of a range are
+    /// stored contiguously; the bytes themselves stay in the caller's buffer.
+    struct INSTRUCTION_EXPORT InstructionRecord
+    {
+        enum Flags
+        {
+            legal = 1,
+            indirect = 2,
+            conditional = 4,
+            hasTarget = 8
+        };
+
+        Address target;             ///< the direct target, if \c hasTarget is set
+        uint32_t offset;            ///< from the start of the decoded range
+        entryID id;
+        unsigned char size;
+        unsigned char category;     ///< an \c InsnCategory
+        unsigned char flags;
+
+        InstructionRecord() :
+            target(0), offset(0), id(e_No_Entry), size(0), category(c_NoCategory), flags(0) {}
+        /// Describe \c insn, found at \c offset into a range and at address \c addr
+        InstructionRecord(const InstructionValue& insn, uint32_t offset, Address addr);
+
+        bool isLegalInsn() const { return flags & legal; }
+        bool isIndirect() const { return flags & indirect; }
+        bool isConditional() const { return flags & conditional; }
+        bool getDirectTarget(Address& t) const { t = target; return flags & hasTarget; }
+        InsnCategory getCategory() const { return (InsnCategory) category; }
+    };
+  };
+};
+
+#endif //!defined(INSTRUCTION_VALUE_H)
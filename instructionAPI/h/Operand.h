@@ -130,7 +130,12 @@ namespace Dyninst
       INSTRUCTION_EXPORT std::string format(Architecture arch, Address addr = 0) const;
 
       /// The \c getValue method returns an %Expression::Ptr to the AST contained by the operand.
+      /// The AST may be a single leaf shared between instructions (see Expression::isShared),
+      /// which ignores \c bind and \c setValue; use \c getUnsharedValue to bind values.
       INSTRUCTION_EXPORT Expression::Ptr getValue() const;
+      /// As \c getValue, but a shared leaf is returned as a new private copy, so that
+      /// values may be bound to the result.
+      INSTRUCTION_EXPORT Expression::Ptr getUnsharedValue() const;
       
     private:
       Expression::Ptr op_value;
@@ -35,6 +35,7 @@
 #include "Expression.h"
 #include "entryIDs.h"
 #include "Result.h"
+#include "FormatBuffer.h"
 #include <set>
 
 #include "util.h"
@@ -115,6 +116,8 @@ namespace Dyninst
       /// Returns the mnemonic for the operation.  Like \c instruction::format, this is exposed for debugging
       /// and will be replaced with stream operators in the public interface.
       INSTRUCTION_EXPORT std::string format() const;
+      /// Appends the mnemonic to \c out, as \c format returns it, without building a string.
+      INSTRUCTION_EXPORT void format(FormatBuffer& out) const;
       /// Returns the entry ID corresponding to this operation.  Entry IDs are enumerated values that correspond
       /// to assembly mnemonics.
       INSTRUCTION_EXPORT entryID getID() const;
@@ -103,9 +103,17 @@ namespace Dyninst
       
       virtual void apply(Visitor* v);
       virtual bool bind(Expression* e, const Result& val);
+      virtual Expression::Ptr unsharedCopy() const;
+
+      /// Returns the interned %RegisterAST for these bits of \c r; see Expression::isShared.
+      /// Safe to call from multiple threads.
+      static RegisterAST::Ptr makeShared(MachRegister r, unsigned int lowbit, unsigned int highbit);
+      static RegisterAST::Ptr makeShared(MachRegister r, unsigned int lowbit, unsigned int highbit,
+                                         Result_Type regType);
 
     protected:
       virtual bool isStrictEqual(const InstructionAST& rhs) const;
+      virtual bool bindsTo(Expression* e) const;
       virtual bool isFlag() const;
       virtual bool checkRegID(MachRegister id, unsigned int low, unsigned int high) const;
       MachRegister getPromotedReg() const;
@@ -131,6 +139,10 @@ namespace Dyninst
 
             virtual std::string format(ArchSpecificFormatter *formatter, formatStyle how = defaultStyle) const;
             virtual std::string format(formatStyle how = defaultStyle) const;
+            virtual Expression::Ptr unsharedCopy() const;
+
+            /// Returns the interned %MaskRegisterAST for these bits of \c r
+            static RegisterAST::Ptr makeShared(MachRegister r, unsigned int lowbit, unsigned int highbit);
     };
   };
 };
@@ -0,0 +1,101 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(REGISTER_MASK_H)
+#define REGISTER_MASK_H
+
+#include "dyn_regs.h"
+#include "util.h"
+
+namespace Dyninst
+{
+  namespace InstructionAPI
+  {
+    /// A %RegisterMask is a fixed-width set of base registers of one architecture.
+    ///
+    /// Every register that is its own base register is given a dense bit number
+    /// by its architecture, in encoding order except that on aarch64 the general
+    /// purpose, flag and special registers come first; \c bitFor and \c regFor translate
+    /// between the two.  Inserting a register folds it to its base register, and on
+    /// x86 and x86-64 the composite \c flags register is expanded into the individual
+    /// flags it stands for, so that two masks may be compared or combined without
+    /// further knowledge of register aliasing.
+    ///
+    /// A register that has no bit (for instance, one of the aarch64 system registers
+    /// beyond the width of the mask) sets \c overflow instead; users of a mask
+    /// that overflowed must fall back to the register sets of the %Instruction.
+    class INSTRUCTION_EXPORT RegisterMask
+    {
+    public:
+      static const unsigned int width = 256;
+
+      RegisterMask();
+
+      /// Add \c r (as its base register) to the mask.
+      void insert(MachRegister r);
+      /// Returns true if the base register of \c r is in the mask.
+      bool contains(MachRegister r) const;
+
+      bool test(unsigned int bit) const
+      {
+          return (m_bits[bit / 64] >> (bit % 64)) & 1;
+      }
+      void set(unsigned int bit)
+      {
+          m_bits[bit / 64] |= ((uint64_t) 1) << (bit % 64);
+      }
+      /// Returns the first bit set after \c bit, or -1 if there is none; \c next(-1)
+      /// returns the first bit set.
+      int next(int bit) const;
+
+      bool empty() const;
+      bool overflow() const { return m_overflow; }
+      void clear();
+
+      RegisterMask& operator|=(const RegisterMask& rhs);
+      RegisterMask& operator&=(const RegisterMask& rhs);
+      bool operator==(const RegisterMask& rhs) const;
+      bool operator!=(const RegisterMask& rhs) const { return !(*this == rhs); }
+
+      /// Returns the bit of \c base, which must be a base register, or -1 if it has none.
+      static int bitFor(MachRegister base);
+      /// Returns the base register numbered \c bit in \c arch, or \c InvalidReg.
+      static MachRegister regFor(Architecture arch, unsigned int bit);
+      /// Returns the number of bits \c arch uses; never more than \c width.
+      static unsigned int size(Architecture arch);
+
+    private:
+      uint64_t m_bits[width / 64];
+      bool m_overflow;
+    };
+  };
+};
+
+#endif //!defined(REGISTER_MASK_H)
@@ -47,6 +47,7 @@ namespace Dyninst {
 
         struct aarch64_insn_entry;
         struct aarch64_mask_entry;
+        struct aarch64_sysreg_entry;
 
         class InstructionDecoder_aarch64 : public InstructionDecoderImpl {
             friend struct aarch64_insn_entry;
@@ -61,6 +62,8 @@ namespace Dyninst {
 
             virtual Instruction::Ptr decode(InstructionDecoder::buffer &b);
 
+            virtual bool decode(InstructionDecoder::buffer &b, InstructionValue &insn);
+
             virtual void setMode(bool) { }
 
             virtual bool decodeOperands(const Instruction *insn_to_complete);
@@ -68,7 +71,8 @@ namespace Dyninst {
             virtual void doDelayedDecode(const Instruction *insn_to_complete);
 
             static std::vector<std::string> condStringMap;
-            static std::map<unsigned int, MachRegister> sysRegMap;
+            static const aarch64_sysreg_entry sysRegTable[];
+            static bool findSysReg(unsigned int encoding, MachRegister &reg);
             static std::map<entryID, std::string> bitfieldInsnAliasMap;
 	    static std::map<entryID, std::string> condInsnAliasMap;
 
@@ -167,8 +171,6 @@ namespace Dyninst {
 
             void reorderOperands();
 
-            static void buildSysRegMap();
-
             unsigned int insn;
             Instruction *insn_in_progress;
 
@@ -275,7 +277,7 @@ namespace Dyninst {
             bool fix_bitfieldinsn_alias(int, int);
 	    void fix_condinsn_alias_and_cond(int &);
 	    void modify_mnemonic_simd_upperhalf_insns();
-            bool pre_process_checks(aarch64_insn_entry *);
+            bool pre_process_checks(const aarch64_insn_entry *);
 
             MachRegister makeAarch64RegID(MachRegister, unsigned int);
 
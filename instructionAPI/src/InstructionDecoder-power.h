@@ -48,6 +48,7 @@ namespace Dyninst {
                 virtual ~InstructionDecoder_power();
                 virtual void decodeOpcode(InstructionDecoder::buffer& b);
                 virtual Instruction::Ptr decode(InstructionDecoder::buffer& b);
+                using InstructionDecoderImpl::decode;
 		virtual void setMode(bool) 
 		{
 		}
@@ -241,12 +242,12 @@ namespace Dyninst {
                             if(field<30, 30>(insn) == 1)
                             {
                                 insn_in_progress->getOperation().mnemonic.insert(where, "a");
-                                return Immediate::makeImmediate(Result(u32,
+                                return makeImmediateExpression(Result(u32,
                                         sign_extend<(highBit - lowBit + 1)>(field<lowBit, highBit>(insn)) << 2));
                             }
                             else
                             {
-                                Expression::Ptr displacement = Immediate::makeImmediate(Result(s32,
+                                Expression::Ptr displacement = makeImmediateExpression(Result(s32,
                                         sign_extend<(highBit - lowBit + 1)>(field<lowBit, highBit>(insn)) << 2));
                                 return makeAddExpression(makeRegisterExpression(ppc32::pc), displacement, s32);
                             }
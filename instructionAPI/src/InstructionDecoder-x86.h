@@ -37,6 +37,7 @@
 
 namespace NS_x86 {
 struct ia32_operand;
+struct ia32_entry;
 class ia32_instruction;
 }
 
@@ -70,6 +71,10 @@ namespace Dyninst
                 INSTRUCTION_EXPORT InstructionDecoder_x86(const InstructionDecoder_x86& o);
             public:
                 INSTRUCTION_EXPORT virtual Instruction::Ptr decode(InstructionDecoder::buffer& b);
+                INSTRUCTION_EXPORT virtual bool decode(InstructionDecoder::buffer& b, InstructionValue& insn);
+                INSTRUCTION_EXPORT virtual bool decodeControlFlow(InstructionDecoder::buffer& b, InstructionValue& insn);
+                INSTRUCTION_EXPORT virtual size_t decodeRange(InstructionDecoder::buffer& b, Address base,
+                                                              std::vector<InstructionRecord>& records);
       
                 INSTRUCTION_EXPORT virtual void setMode(bool is64);
                 virtual void doDelayedDecode(const Instruction* insn_to_complete);
@@ -92,15 +97,37 @@ namespace Dyninst
                 MachRegister makeRegisterID(unsigned int intelReg, unsigned int opType, bool isExtendedReg = false);
                 Expression::Ptr decodeImmediate(unsigned int opType, const unsigned char* immStart, bool isSigned = false);
                 virtual Result_Type makeSizeType(unsigned int opType);
+                MachRegister makeImplicitRegisterID(const InstructionDecoder::buffer& b,
+                                                    unsigned int optype, bool firstOperand);
+
+                // Counterparts of the above that describe operands as
+                // OperandValues rather than expression trees
+                bool decodeOneOperandValue(const InstructionDecoder::buffer& b,
+                                           const NS_x86::ia32_operand& operand,
+                                           int & imm_index,
+                                           InstructionValue& insn,
+                                           bool isRead, bool isWritten, bool isImplicit);
+                void makeModRMValue(const InstructionDecoder::buffer& b,
+                                    unsigned int opType, OperandValue& op);
+                void makeSIBValue(const InstructionDecoder::buffer& b, OperandValue& op);
+                int64_t getModRMDisplacementValue(const InstructionDecoder::buffer& b);
+                bool decodeImmediateValue(unsigned int opType, const unsigned char* immStart,
+                                          int64_t& val, bool isSigned = false);
 
             private:
                 void doIA32Decode(InstructionDecoder::buffer& b);
+                NS_x86::ia32_entry* decodeEntry(InstructionDecoder::buffer& b, bool lengthOnly = false);
+                bool decodeValueHeader(InstructionDecoder::buffer& b, InstructionValue& insn,
+                                       bool lengthOnly = false);
+                bool decodeTargetDisp(const unsigned char* start, int64_t& disp, bool& indirect);
 		bool isDefault64Insn();
 		
                 static TLS_VAR ia32_locations* locs;
                 static TLS_VAR NS_x86::ia32_instruction* decodedInstruction;
                 static TLS_VAR bool sizePrefixPresent;
                 static TLS_VAR bool addrSizePrefixPresent;
+                // The operation of the last decoded instruction
+                entryID decodedID;
         };
     };
 };
@@ -38,6 +38,9 @@
 #include "Instruction.h"
 #include "InstructionDecoder.h" // buffer...anything else?
 
+#include <boost/thread/tss.hpp>
+#include "dyntypes.h"
+
 namespace Dyninst
 {
 namespace InstructionAPI
@@ -50,6 +53,10 @@ class InstructionDecoderImpl
         InstructionDecoderImpl(Architecture a) : m_Arch(a) {}
         virtual ~InstructionDecoderImpl() {}
         virtual Instruction::Ptr decode(InstructionDecoder::buffer& b);
+        virtual bool decode(InstructionDecoder::buffer& b, InstructionValue& insn);
+        virtual bool decodeControlFlow(InstructionDecoder::buffer& b, InstructionValue& insn);
+        virtual size_t decodeRange(InstructionDecoder::buffer& b, Address base,
+                                   std::vector<InstructionRecord>& records);
         virtual void doDelayedDecode(const Instruction* insn_to_complete) = 0;
         virtual void setMode(bool is64) = 0;
         static Ptr makeDecoderImpl(Architecture a);
@@ -67,9 +74,11 @@ class InstructionDecoderImpl
         virtual Expression::Ptr makeRightLogicalShiftExpression(Expression::Ptr lhs, Expression::Ptr rhs, Result_Type resultType);
 		virtual Expression::Ptr makeRightRotateExpression(Expression::Ptr lhs, Expression::Ptr rhs, Result_Type resultType);
         virtual Expression::Ptr makeDereferenceExpression(Expression::Ptr addrToDereference, Result_Type resultType);
+        MachRegister archRegister(MachRegister reg);
         virtual Expression::Ptr makeRegisterExpression(MachRegister reg);
         virtual Expression::Ptr makeMaskRegisterExpression(MachRegister reg);
         virtual Expression::Ptr makeRegisterExpression(MachRegister reg, Result_Type extendFrom);
+        Expression::Ptr makeImmediateExpression(const Result& val);
         virtual Result_Type makeSizeType(unsigned int opType) = 0;
         Instruction* makeInstruction(entryID opcode, const char* mnem, unsigned int decodedSize,
                                      const unsigned char* raw);
@@ -77,7 +86,13 @@ class InstructionDecoderImpl
     protected:
         Operation::Ptr m_Operation;
         Architecture m_Arch;
-        static std::map<Architecture, Ptr> impls;
+        // Per-thread front ends to the shared leaf tables, so that a
+        // decoder only takes their locks the first time it sees a leaf
+        dyn_hash_map<uint64_t, Expression::Ptr> sharedRegisters;
+        dyn_hash_map<uint64_t, Expression::Ptr> sharedImmediates;
+        // Decoder implementations keep per-instruction scratch state, so
+        // each thread gets its own set
+        static boost::thread_specific_ptr<std::map<Architecture, Ptr> > impls;
       
 };
 
@@ -0,0 +1,95 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * Helpers shared by the instructionAPI tests and benchmarks.
+ */
+
+#if !defined(INSTRUCTIONAPI_TEST_SWEEP_H)
+#define INSTRUCTIONAPI_TEST_SWEEP_H
+
+#include <elf.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+
+#include "dyntypes.h"
+
+// Reads the .text section of a 64-bit ELF file, and the architecture
+// it is for
+static bool read_text(const char * path, std::vector<unsigned char> & text,
+                      Dyninst::Address & base, Dyninst::Architecture & arch)
+{
+    FILE * f = fopen(path, "rb");
+    if(!f) return false;
+    std::vector<unsigned char> file;
+    unsigned char chunk[65536];
+    size_t n;
+    while((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+        file.insert(file.end(), chunk, chunk + n);
+    fclose(f);
+
+    if(file.size() < sizeof(Elf64_Ehdr) || memcmp(&file[0], ELFMAG, SELFMAG) ||
+       file[EI_CLASS] != ELFCLASS64)
+        return false;
+    Elf64_Ehdr * eh = (Elf64_Ehdr *) &file[0];
+    switch(eh->e_machine) {
+        case EM_X86_64: arch = Dyninst::Arch_x86_64; break;
+        case EM_AARCH64: arch = Dyninst::Arch_aarch64; break;
+        case EM_PPC64: arch = Dyninst::Arch_ppc64; break;
+        default: return false;
+    }
+    if(eh->e_shoff + eh->e_shnum * sizeof(Elf64_Shdr) > file.size())
+        return false;
+    Elf64_Shdr * sh = (Elf64_Shdr *) &file[eh->e_shoff];
+    const char * names = (const char *) &file[sh[eh->e_shstrndx].sh_offset];
+    for(unsigned i = 0; i < eh->e_shnum; ++i) {
+        if(strcmp(names + sh[i].sh_name, ".text")) continue;
+        if(sh[i].sh_offset + sh[i].sh_size > file.size()) return false;
+        text.assign(&file[sh[i].sh_offset], &file[sh[i].sh_offset + sh[i].sh_size]);
+        base = sh[i].sh_addr;
+        return true;
+    }
+    return false;
+}
+
+// Deterministic pseudo-random code (a linear congruential generator)
+static std::vector<unsigned char> random_code(size_t len, unsigned seed)
+{
+    std::vector<unsigned char> code(len);
+    for(size_t i = 0; i < len; ++i) {
+        seed = seed * 1103515245 + 12345;
+        code[i] = (unsigned char) (seed >> 16);
+    }
+    return code;
+}
+
+#endif
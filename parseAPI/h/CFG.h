@@ -56,6 +56,7 @@ namespace ParseAPI {
 
 class LoopAnalyzer;
 class dominatorCFG;
+class dominatorTree;
 class CodeObject;
 class CFGModifier;
 
@@ -289,6 +290,8 @@ class PARSER_EXPORT Block : public Dyninst::SimpleInterval<Address, int>,
     friend class CFGModifier;
  public:
     typedef std::map<Offset, InstructionAPI::InstructionPtr> Insns;
+    typedef std::vector<std::pair<InstructionAPI::InstructionPtr, Offset> > InsnVec;
+    typedef boost::shared_ptr<InsnVec const> InsnVecPtr;
     typedef std::vector<Edge*> edgelist;
 
     Block(CodeObject * o, CodeRegion * r, Address start);
@@ -318,6 +321,9 @@ class PARSER_EXPORT Block : public Dyninst::SimpleInterval<Address, int>,
 
     void getInsns(Insns &insns) const;
     InstructionAPI::InstructionPtr getInsn(Offset o) const;
+    // Instructions in address order; shared through the CodeObject's
+    // instruction store when it is enabled
+    InsnVecPtr getInsnVec() const;
 
     bool wasUserAdded() const;
 
@@ -557,13 +563,17 @@ class PARSER_EXPORT Function : public allocatable, public AnnotatableSparse {
 
     /* This should not remain here - this is an experimental fix for
        defensive mode CFG inconsistency */
-    void invalidateCache() { _cache_valid = false; }
+    void invalidateCache();
 
     static void destroy(Function *f);
 
  private:
     void delayed_link_return(CodeObject * co, Block * retblk);
     void finalize();
+    // drop all parse results, returning to the unparsed state
+    void discard_cfg();
+    // drop the loops and dominator trees computed from the blocks
+    void discard_analyses();
 
     bool _parsed;
     bool _cache_valid;
@@ -628,21 +638,17 @@ class PARSER_EXPORT Function : public allocatable, public AnnotatableSparse {
     mutable bool _loop_analyzed; // true if loops in the function have been found and stored in _loops
     mutable std::set<Loop*> _loops;
     mutable LoopTreeNode *_loop_root; // NULL if the tree structure has not be calculated
+    bool _analyses_stale; // the blocks changed after loops or dominators were computed
     void getLoopsByNestingLevel(std::vector<Loop*>& lbb, bool outerMostOnly) const;
 
 
     /* Dominator and post-dominator info details */
-    mutable bool isDominatorInfoReady;
-    mutable bool isPostDominatorInfoReady;
     void fillDominatorInfo() const;
     void fillPostDominatorInfo() const;
-    /** set of basic blocks that this basicblock dominates immediately*/
-    mutable std::map<Block*, std::set<Block*>*> immediateDominates;
-    /** basic block which is the immediate dominator of the basic block */
-    mutable std::map<Block*, Block*> immediateDominator;
-    /** same as previous two fields, but for postdominator tree */
-    mutable std::map<Block*, std::set<Block*>*> immediatePostDominates;
-    mutable std::map<Block*, Block*> immediatePostDominator;
+    /** dominator tree over the blocks of the function; NULL until computed */
+    mutable dominatorTree *_dom;
+    /** same as previous field, but for postdominator tree */
+    mutable dominatorTree *_postdom;
 
     /*** Internal parsing methods and state ***/
     void add_block(Block *b);
@@ -95,6 +95,12 @@ class fact_list {
         while(head.alloc_next() != &head)
             head.alloc_next()->remove();
     }
+
+    // forget all elements without touching them
+    void reset() {
+        head.alloc_set_next(&head);
+        head.alloc_set_prev(&head);
+    }
     
     // iterators
     iterator begin() { return iterator(head.alloc_next()); }
@@ -158,6 +164,51 @@ class PARSER_EXPORT CFGFactory {
     fact_list<Function> funcs_;
 };
 
+class CFGArena;
+
+/** A CFGFactory that allocates the default CFG objects from slab
+    arenas owned by the factory. Freed objects are recycled, and
+    destroying the factory releases all objects in bulk rather than
+    one at a time. This is the factory a CodeObject uses if it is not
+    given one. **/
+
+class PARSER_EXPORT ArenaCFGFactory : public CFGFactory {
+ public:
+    ArenaCFGFactory();
+    virtual ~ArenaCFGFactory();
+
+    /* Memory accounting, per kind of CFG object */
+    struct arena_stats {
+        size_t object_bytes;    // bytes per object, including padding
+        size_t live;            // objects currently allocated
+        size_t reserved_bytes;  // bytes held by the arena
+    };
+    arena_stats funcStats() const;
+    arena_stats blockStats() const;
+    arena_stats edgeStats() const;
+
+ protected:
+    virtual Function * mkfunc(Address addr, FuncSource src,
+            std::string name, CodeObject * obj, CodeRegion * region,
+            Dyninst::InstructionSource * isrc);
+    virtual Block * mkblock(Function * f, CodeRegion * r,
+            Address addr);
+    virtual Edge * mkedge(Block * src, Block * trg,
+            EdgeTypeEnum type);
+    virtual Block * mksink(CodeObject *obj, CodeRegion *r);
+
+    virtual void free_func(Function * f);
+    virtual void free_block(Block * b);
+    virtual void free_edge(Edge * e);
+
+ private:
+    void release_all();
+
+    CFGArena * funcs_arena_;
+    CFGArena * blocks_arena_;
+    CFGArena * edges_arena_;
+};
+
 
 
     }
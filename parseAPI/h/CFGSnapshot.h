@@ -0,0 +1,120 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#ifndef _CFG_SNAPSHOT_H_
+#define _CFG_SNAPSHOT_H_
+
+#include <vector>
+
+#include "dyntypes.h"
+#include "CFG.h"
+
+namespace Dyninst {
+namespace ParseAPI {
+
+/*
+ * A read-only copy of the interprocedural CFG and call graph of a
+ * CodeObject in compressed sparse row form, produced by
+ * CodeObject::snapshot().
+ *
+ * Blocks and functions are given dense ids in address order. The
+ * out-edges of block b are out_target[i], out_type[i] and out_flags[i]
+ * for i in [out_offset[b], out_offset[b+1]); in-edges are laid out the
+ * same way from in_offset. Edges to the sink block have target SINK.
+ * The blocks of function f are func_block[func_block_offset[f] ..
+ * func_block_offset[f+1]), and its calls are call_callee[i] (a function
+ * id, or NONE for calls to unknown targets) made from block
+ * call_site[i] for i in [call_offset[f], call_offset[f+1]).
+ *
+ * All arrays are contiguous, so data() may be handed directly to
+ * external graph code. The snapshot does not track later changes to
+ * the CFG, and the Block and Function pointers it records are only
+ * valid while those objects are.
+ */
+class PARSER_EXPORT CFGSnapshot {
+ public:
+    typedef unsigned int id_t;
+    static const id_t NONE = (id_t) -1;
+    static const id_t SINK = (id_t) -2;
+
+    // out_flags / in_flags bits
+    static const unsigned char INTERPROC = 0x1;
+
+    CFGSnapshot() { }
+
+    id_t numBlocks() const { return blocks.size(); }
+    id_t numEdges() const { return out_target.size(); }
+    id_t numFuncs() const { return funcs.size(); }
+
+    // Dense id of b or f, or NONE if it is not in the snapshot
+    id_t blockId(Block * b) const;
+    id_t funcId(Function * f) const;
+
+    void clear();
+
+    /* Blocks */
+    std::vector<Block *> blocks;
+    std::vector<Address> block_start;
+    std::vector<Address> block_end;
+
+    /* Edges by source */
+    std::vector<id_t> out_offset;
+    std::vector<id_t> out_target;
+    std::vector<unsigned char> out_type;    // EdgeTypeEnum
+    std::vector<unsigned char> out_flags;
+
+    /* Edges by target */
+    std::vector<id_t> in_offset;
+    std::vector<id_t> in_source;
+    std::vector<unsigned char> in_type;
+    std::vector<unsigned char> in_flags;
+
+    /* Functions */
+    std::vector<Function *> funcs;
+    std::vector<id_t> func_entry;           // block id
+    std::vector<id_t> func_block_offset;
+    std::vector<id_t> func_block;
+
+    /* Call graph */
+    std::vector<id_t> call_offset;
+    std::vector<id_t> call_site;            // block id
+    std::vector<id_t> call_callee;          // function id
+
+ private:
+    friend class CodeObject;
+    void build(CodeObject * obj);
+
+    dyn_hash_map<Block *, id_t> block_ids;
+    dyn_hash_map<Function *, id_t> func_ids;
+};
+
+}
+}
+
+#endif
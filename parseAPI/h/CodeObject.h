@@ -42,8 +42,15 @@
 #include "ParseContainers.h"
 
 namespace Dyninst {
+class AssignmentCache;
+namespace InsnAdapter {
+class IA_IAPI;
+}
 namespace ParseAPI {
 
+class InsnStore;
+class CFGSnapshot;
+
 /** A CodeObject defines a collection of binary code, for example a binary,
     dynamic library, archive, memory snapshot, etc. In the context of
     Dyninst, it maps to an image object.
@@ -61,6 +68,9 @@ typedef enum {
 
 class CodeObject {
    friend class CFGModifier;
+   // instruction adapters consume instructions decoded ahead by the parser
+   friend class InsnAdapter::IA_IAPI;
+   friend class Block;
  public:
     PARSER_EXPORT static void version(int& major, int& minor, int& maintenance);
     typedef std::set<Function*,Function::less> funclist;
@@ -97,6 +107,132 @@ class CodeObject {
     // `speculative' parsing
     PARSER_EXPORT void parseGaps(CodeRegion *cr, GapParsingType type=IdiomMatching);
 
+    /*
+     * Parallel parsing. With more than one thread, hint-based parsing
+     * decodes the code reachable from each hint on worker threads
+     * while the CFG is constructed. CFG construction itself proceeds
+     * in the same order as a single-threaded parse, so the resulting
+     * CFG is identical. Not used in defensive mode or for code sources
+     * with overlapping regions.
+     */
+    PARSER_EXPORT void setParseThreads(unsigned int threads);
+    PARSER_EXPORT unsigned int parseThreads() const { return parse_threads; }
+
+    /*
+     * Persistent CFG cache. If a cache directory is set, the CFG
+     * produced by parse() is saved there, keyed by the binary's
+     * build-id, and later parse() calls on the same binary load it
+     * instead of parsing. Stale or corrupt cache files are ignored.
+     * Defaults to $DYNINST_PARSE_CACHE_DIR; an empty directory
+     * disables the cache. loadedFromCache() tells whether the last
+     * parse() loaded the CFG.
+     */
+    PARSER_EXPORT void setParseCacheDir(std::string const& dir) { parse_cache_dir = dir; }
+    PARSER_EXPORT std::string const& parseCacheDir() const { return parse_cache_dir; }
+    PARSER_EXPORT bool loadedFromCache() const;
+
+    /*
+     * Incremental parsing across builds. If set, the first parse()
+     * reads a CFG cache image written for an earlier build of this
+     * binary and reuses the blocks and edges of each function whose
+     * code is unchanged apart from its position, matching functions by
+     * symbol name. Changed functions, functions whose calls no longer
+     * reach a function of the same name, and functions with jump tables
+     * or code shared with other functions are parsed as usual. A reused
+     * function whose callees' return status changed is parsed again.
+     * Defaults to $DYNINST_PARSE_PREVIOUS_CFG.
+     *
+     * After the parse, reusedPreviousCFG(f) tells whether f kept the
+     * reused CFG, and the counts give how many functions did and how
+     * many reused functions were parsed again.
+     */
+    PARSER_EXPORT void setPreviousCFG(std::string const& path) { prev_cfg_path = path; }
+    PARSER_EXPORT std::string const& previousCFG() const { return prev_cfg_path; }
+    PARSER_EXPORT bool reusedPreviousCFG(Function * f) const;
+    PARSER_EXPORT size_t previousCFGReused() const;
+    PARSER_EXPORT size_t previousCFGReparsed() const;
+
+    /*
+     * Decoded instruction store. When enabled, Block::getInsnVec() and
+     * the analyses built on it share one decoded copy of each block's
+     * instructions. At most max_insns instructions are kept; the least
+     * recently used blocks are evicted first. Disabled (0) by default.
+     */
+    PARSER_EXPORT void setInsnCacheSize(size_t max_insns);
+    PARSER_EXPORT size_t insnCacheSize() const;
+
+    /*
+     * Assignment cache shared by the AssignmentConverters that convert
+     * instructions of this CodeObject. At most max_assigns assignments
+     * are kept; 0 disables sharing, so each converter caches privately.
+     */
+    PARSER_EXPORT void setAssignCacheSize(size_t max_assigns);
+    PARSER_EXPORT size_t assignCacheSize() const;
+    PARSER_EXPORT AssignmentCache * assignCache() const { return assign_cache; }
+
+    /*
+     * Parse profiling. Records wall time per parsing phase (parsing,
+     * decoding, jump table analysis, tail call detection, gap parsing
+     * and finalization) and per function, and writes it as JSON to
+     * path ("-" for stderr) when this CodeObject is destroyed; the
+     * top_funcs most expensive functions are listed. Defaults to
+     * $DYNINST_PARSE_PROFILE and $DYNINST_PARSE_PROFILE_TOP; an empty
+     * path disables profiling.
+     */
+    PARSER_EXPORT void setParseProfile(std::string const& path, unsigned int top_funcs = 20);
+
+    /*
+     * Bounded on-demand parsing. Lookups parse only what they need:
+     * findFuncByEntry parses the function at that entry, and address
+     * lookups parse the nearest function at or below the address, each
+     * without following calls. Function::blocks() and friends parse an
+     * unparsed function by itself. parse() still parses everything.
+     *
+     * With a nonzero budget, parsed functions are evicted, least
+     * recently used first, whenever the estimated memory held by their
+     * CFGs exceeds budget bytes. An evicted function keeps its Function
+     * object but its blocks and edges are destroyed, with the usual
+     * ParseCallback notifications; it is parsed again when next used.
+     * Functions reached by edges from outside of them are not evicted,
+     * nor are pinned functions: pin functions that are instrumented or
+     * modified. Unavailable in defensive mode and for code sources with
+     * overlapping regions.
+     */
+    PARSER_EXPORT void setOnDemandParsing(bool enable, size_t budget = 0);
+    PARSER_EXPORT bool onDemandParsing() const;
+    PARSER_EXPORT void pinFunction(Function * f, bool pin = true);
+    PARSER_EXPORT size_t residentBytes() const;
+
+    /*
+     * Frozen state. freeze() completes parsing and finalization, then
+     * computes every function's loops, loop tree and dominator and
+     * post-dominator trees, using parseThreads() threads. While frozen,
+     * the lookup routines below and the Function, Block and Loop
+     * queries for blocks, extents, call edges, exit and return blocks,
+     * loops and (post-)dominators only read the CFG and may be called
+     * concurrently from any number of threads.
+     *
+     * The guarantee covers only those CFG queries. Instructions of
+     * blocks, dataflow analyses and annotations have their own caches
+     * and are not made safe for concurrent use by freezing.
+     *
+     * Parsing more code, destroying CFG objects, modifying the CFG
+     * with CFGModifier or enabling on-demand parsing thaws the object;
+     * freeze() it again before resuming concurrent queries. Loops and
+     * dominator trees of functions whose blocks changed are recomputed
+     * then, which frees Loop objects obtained before the change.
+     * Freezing turns off on-demand parsing.
+     */
+    PARSER_EXPORT void freeze();
+    PARSER_EXPORT bool frozen() const { return is_frozen; }
+
+    /*
+     * Fill snap with a compressed sparse row copy of the CFG and call
+     * graph of every function in this object; see CFGSnapshot.h.
+     * Completes any outstanding parsing first.
+     */
+    PARSER_EXPORT void snapshot(CFGSnapshot & snap);
+
     /** Lookup routines **/
 
     // functions
@@ -167,9 +303,16 @@ class CodeObject {
     friend void Function::delayed_link_return(CodeObject *,Block*);
     // allows Functions to finalize (need Parser access)
     friend void Function::finalize();
+    // and to thaw the CodeObject when their blocks are about to change
+    friend void Function::invalidateCache();
     // allows Function entry blocks to be moved to new regions
     friend void Function::setEntryBlock(Block *);
 
+    // precomputes the lazily built analyses of one function
+    static void freeze_func(Function * const & f);
+    // called by every path that changes the CFG
+    void thaw() { is_frozen = false; }
+
   private:
     CodeSource * _cs;
     CFGFactory * _fact;
@@ -179,6 +322,12 @@ class CodeObject {
 
     bool owns_factory;
     bool defensive;
+    bool is_frozen;
+    unsigned int parse_threads;
+    std::string parse_cache_dir;
+    std::string prev_cfg_path;
+    InsnStore * insn_store;
+    AssignmentCache * assign_cache;
     funclist& flist;
 };
 
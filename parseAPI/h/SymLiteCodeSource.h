@@ -32,6 +32,7 @@
 #define _SYMLITE_CODE_SOURCE_H_
 
 #include <map>
+#include <set>
 #include <vector>
 #include <utility>
 #include <string>
@@ -85,6 +86,9 @@ class SymReaderCodeSource : public CodeSource {
     bool owns_symtab;
     mutable CodeRegion * _lookup_cache;
 
+    // Entries of function symbols with a known non-returning name
+    std::set<Address> _nonreturning;
+
     // Stats information
     StatContainer * stats_parse;
     bool _have_stats;
@@ -134,6 +138,8 @@ class SymReaderCodeSource : public CodeSource {
     void overlapping_warn(const char * file, unsigned line) const;
     
     void init_regions();
+    void init_hints();
+    void init_linkage();
     
     // statistics
     bool init_stats();
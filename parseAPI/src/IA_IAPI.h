@@ -44,6 +44,9 @@
 using namespace std;
 
 namespace Dyninst {
+namespace ParseAPI {
+class ParseProfile;
+}
 namespace InsnAdapter {
 
 class IA_IAPI : public InstructionAdapter {
@@ -153,6 +156,15 @@ protected:
         Dyninst::InstructionAPI::Instruction::Ptr curInsn() const;
         allInsns_t::iterator curInsnIter;
 
+        // Decodes the instruction at `current', preferring one the
+        // parser has already decoded. The decoder's position is stale
+        // after such an instruction is used.
+        Dyninst::InstructionAPI::Instruction::Ptr decodeCurrent();
+        bool decStale;
+
+        // the owning parser's profile, if parsing is being profiled
+        ParseAPI::ParseProfile * profile() const;
+
         mutable bool validCFT;
         mutable std::pair<bool, Address> cachedCFT;
         mutable bool validLinkerStubState;
@@ -8,15 +8,67 @@
 #include "BoundFactCalculator.h"
 using namespace Dyninst;
 
+// Results of jump table analysis that can be reused by later
+// analyses of indirect jumps in the same function. Entries are
+// validated against the current shape of the CFG before reuse.
+struct JumpTableCache {
+    // Thunk calls found in a block, by block start
+    struct BlockThunks {
+        ParseAPI::Block *block;
+        Address end;
+        std::vector<std::pair<Address, ThunkInfo> > thunks;
+
+        BlockThunks() : block(NULL), end(0) {}
+    };
+    std::map<Address, BlockThunks> blockThunks;
+
+    // Bound of a jump table index, by the assignment defining the
+    // index. Each bound records the inputs of the slice it came from:
+    // the blocks the slice visited, with their extents, and the edges
+    // into them and the conditional edges out of them, sorted. It is
+    // reused while those are unchanged, however the rest of the
+    // function grows.
+    struct BoundKey {
+        Address addr;
+        AbsRegion index;
+        bool entry;
+
+        bool operator<(const BoundKey &rhs) const;
+    };
+    struct SliceEdge {
+        Address src;
+        Address trg;
+        int type;
+
+        bool operator<(const SliceEdge &rhs) const;
+        bool operator==(const SliceEdge &rhs) const;
+    };
+    struct BoundFact {
+        bool found;
+        StridedInterval bound;
+        std::vector<std::pair<ParseAPI::Block *, Address> > blocks;
+        std::vector<SliceEdge> edges;
+    };
+    std::map<BoundKey, std::vector<BoundFact> > bounds;
+
+    unsigned hits;
+    unsigned misses;
+
+    JumpTableCache() : hits(0), misses(0) {}
+};
+
 class IndirectControlFlowAnalyzer {
     // The function and block that contain the indirect jump
     ParseAPI::Function *func;
     ParseAPI::Block *block;
     set<ParseAPI::Block*> reachable;
     ThunkData thunks;
+    JumpTableCache *cache;
 
     void GetAllReachableBlock();  
     void FindAllThunks();
+    void FindThunks(ParseAPI::Block *b, std::vector<std::pair<Address, ThunkInfo> > &found);
+    bool BoundIndex(Assignment::Ptr indexLoc, AbsRegion &index, SymbolicExpression &se, StridedInterval &bound);
     void ReadTable(AST::Ptr, 
                    AbsRegion, 
 		   StridedInterval &,  
@@ -28,7 +80,7 @@ class IndirectControlFlowAnalyzer {
 
 public:
     bool NewJumpTableAnalysis(std::vector<std::pair< Address, Dyninst::ParseAPI::EdgeTypeEnum > >& outEdges);
-    IndirectControlFlowAnalyzer(ParseAPI::Function *f, ParseAPI::Block *b): func(f), block(b) {}
+    IndirectControlFlowAnalyzer(ParseAPI::Function *f, ParseAPI::Block *b, JumpTableCache *c = NULL): func(f), block(b), cache(c) {}
 
 };
 
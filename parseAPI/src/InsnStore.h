@@ -0,0 +1,96 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _INSN_STORE_H_
+#define _INSN_STORE_H_
+
+#include <list>
+
+#include <boost/thread/mutex.hpp>
+
+#include "dyntypes.h"
+#include "CFG.h"
+
+namespace Dyninst {
+namespace ParseAPI {
+
+/*
+ * Per-CodeObject store of decoded block instructions, bounded by the
+ * total number of instructions held. Entries are keyed by block start
+ * and checked against the block's current extent and a hash of its
+ * bytes, so blocks that have since been split or whose code has been
+ * rewritten are decoded again. Arrays are handed out by shared pointer
+ * and stay valid after eviction.
+ *
+ * Stored instructions are shared between threads, so their operands are
+ * decoded before they are published rather than lazily on first use.
+ */
+class InsnStore {
+ public:
+    InsnStore(size_t max_insns);
+    ~InsnStore();
+
+    Block::InsnVecPtr get(Block const* b);
+    void remove(Block const* b);
+
+    void set_limit(size_t max_insns);
+    size_t limit() const { return _max; }
+
+    static void decode(Block const* b, Block::InsnVec & insns);
+
+    static uint64_t code_hash(Block const* b);
+
+ private:
+    struct entry {
+        CodeRegion * region;
+        Address end;
+        uint64_t hash;
+        Block::InsnVecPtr insns;
+        std::list<Address>::iterator pos;
+    };
+
+    void erase(dyn_hash_map<Address, entry>::iterator eit);
+    void evict();
+
+    boost::mutex _lock;
+    dyn_hash_map<Address, entry> _entries;
+    std::list<Address> _lru;    // most recently used first
+    size_t _size;               // instructions held
+    size_t _max;
+
+    size_t _hits;
+    size_t _misses;
+    size_t _evictions;
+};
+
+}
+}
+
+#endif
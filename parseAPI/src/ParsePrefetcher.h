@@ -0,0 +1,122 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#ifndef _PARSE_PREFETCHER_H_
+#define _PARSE_PREFETCHER_H_
+
+#include <vector>
+#include <map>
+#include <utility>
+#include <atomic>
+
+#include "dyntypes.h"
+#include "Instruction.h"
+#include "CodeSource.h"
+
+#include "common/src/dthread.h"
+#include "common/src/work_stealing_pool.h"
+
+namespace Dyninst {
+namespace ParseAPI {
+
+/*
+ * Decodes instructions ahead of the parser on worker threads.
+ *
+ * Starting from each seed address, a worker follows fallthrough and
+ * direct branch edges within the seed's region (calls are assumed to
+ * return) and publishes the decoded instructions. The parser takes
+ * instructions out of the table as it reaches them; anything it does
+ * not find is decoded in the usual way. The prefetcher never touches
+ * the CFG, so the order and outcome of CFG construction do not depend
+ * on the number of workers.
+ *
+ * The parser reports the seed it is working on with advance(). Workers
+ * stay within a window of seeds ahead of it and decode a bounded number
+ * of instructions per seed, so the untaken instructions of seeds the
+ * parser has not reached fit in `budget'. Instructions of seeds the
+ * parser has passed without taking them (code after non-returning
+ * calls, data reached by the assumed fallthroughs) are evicted oldest
+ * first to make room.
+ */
+class ParsePrefetcher {
+ public:
+    typedef std::pair<CodeRegion *, Address> seed_t;
+
+    ParsePrefetcher(unsigned nthreads, size_t budget);
+    ~ParsePrefetcher();
+
+    // seeds are processed roughly in the order given
+    void start(const std::vector<seed_t> & seeds);
+    void stop();
+
+    // the parser has started on the function at entry
+    void advance(Address entry);
+
+    InstructionAPI::Instruction::Ptr take(Address addr);
+
+ private:
+    struct work_t {
+        CodeRegion * region;
+        Address addr;
+        unsigned index;     // position in the parser's order
+    };
+    struct entry_t {
+        InstructionAPI::Instruction::Ptr insn;
+        unsigned seed;
+    };
+    typedef std::vector<std::pair<Address,
+        InstructionAPI::Instruction::Ptr> > insn_run_t;
+
+    void decode_from(work_t & seed);
+    bool wait_for_parser(unsigned index);
+    void publish(insn_run_t & run, unsigned seed);
+    bool make_room(size_t n);
+
+    WorkStealingPool<work_t> _pool;
+    CondVar<> _cond;
+    dyn_hash_map<Address, entry_t> _insns;
+    // published addresses by seed, for eviction
+    std::map<unsigned, std::vector<Address> > _by_seed;
+    dyn_hash_map<Address, unsigned> _seeds;
+    size_t _budget;
+    unsigned _window;       // seeds a worker may run ahead of the parser
+    size_t _per_seed;       // instructions decoded per seed
+    unsigned _frontier;     // latest seed the parser has reached
+    std::atomic<bool> _stopping;
+
+    // statistics, protected by _cond
+    unsigned long _published;
+    unsigned long _taken;
+    unsigned long _evicted;
+};
+
+}
+}
+
+#endif
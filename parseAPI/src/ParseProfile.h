@@ -0,0 +1,138 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _PARSE_PROFILE_H_
+#define _PARSE_PROFILE_H_
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "dyntypes.h"
+
+namespace Dyninst {
+namespace ParseAPI {
+
+class Function;
+
+/*
+ * Wall-clock profile of a parse, broken down by phase and by function.
+ * Phase times are inclusive: gap parsing, for example, includes the
+ * decoding, jump table analysis and finalization it triggers. Time
+ * spent parsing a function's frames, together with the phases entered
+ * while doing so, is charged to that function. Only the parsing thread
+ * records into the profile.
+ *
+ * The profile is written as JSON to a file ("-" for stderr) when the
+ * owning CodeObject is destroyed.
+ */
+class ParseProfile {
+ public:
+    typedef std::chrono::steady_clock clock;
+
+    enum phase_t {
+        PARSE = 0,
+        DECODE,
+        JUMPTABLE,
+        TAILCALL,
+        GAPS,
+        FINALIZE,
+        NUM_PHASES
+    };
+
+ private:
+    struct cost {
+        clock::duration total;
+        unsigned long count;
+        cost() : total(clock::duration::zero()), count(0) { }
+    };
+    struct func_cost {
+        Function * func;    // NULL once the function is destroyed
+        std::string name;
+        Address addr;
+        cost self;
+        cost phases[NUM_PHASES];
+        func_cost(Function * f) : func(f), addr(0) { }
+    };
+
+ public:
+    /* Times a phase for the lifetime of the scope; no-op without a profile */
+    class Scope {
+     public:
+        Scope(ParseProfile * p, phase_t ph) : _p(p), _ph(ph) {
+            if(_p) _start = clock::now();
+        }
+        ~Scope() {
+            if(_p) _p->add(_ph, clock::now() - _start);
+        }
+     private:
+        ParseProfile * _p;
+        phase_t _ph;
+        clock::time_point _start;
+    };
+
+    /* Charges the time of the scope, and the phases in it, to f */
+    class FuncScope {
+     public:
+        FuncScope(ParseProfile * p, Function * f);
+        ~FuncScope();
+     private:
+        ParseProfile * _p;
+        func_cost * _prev;
+        clock::time_point _start;
+    };
+
+    ParseProfile(std::string const& path, unsigned top_funcs);
+    ~ParseProfile();
+
+    void add(phase_t ph, clock::duration d);
+    // f is about to be destroyed
+    void forget(Function * f);
+    bool dump() const;
+
+    static char const* phase_name(phase_t ph);
+
+ private:
+    std::string _path;
+    unsigned _top;
+    clock::time_point _created;
+    cost _phases[NUM_PHASES];
+    dyn_hash_map<Function *, func_cost *> _funcs;
+    std::vector<func_cost *> _records;  // including destroyed functions
+    func_cost * _current;
+
+    ParseProfile(ParseProfile const&);
+    ParseProfile & operator=(ParseProfile const&);
+};
+
+}
+}
+
+#endif
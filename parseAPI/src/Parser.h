@@ -31,6 +31,7 @@
 #define _PARSER_H_
 
 #include <set>
+#include <list>
 #include <vector>
 #include <queue>
 #include <utility>
@@ -46,12 +47,16 @@
 #include "ParseCallback.h"
 
 #include "ParseData.h"
+#include "ParsePrefetcher.h"
+#include "ParseProfile.h"
 #include "common/src/dthread.h"
 
 using namespace std;
 
 typedef Dyninst::InsnAdapter::IA_IAPI InstructionAdapter_t;
 
+struct JumpTableCache;
+
 namespace Dyninst {
 namespace ParseAPI {
 
@@ -97,6 +102,45 @@ class Parser {
     // a sink block for unbound edges
     Block * _sink;
 
+    // instructions decoded ahead of parsing, if parsing in parallel
+    ParsePrefetcher * _prefetch;
+
+    // jump table analysis results of functions being parsed
+    dyn_hash_map<Function *, JumpTableCache *> _jumptable_caches;
+
+    // parse-phase profile, if profiling
+    ParseProfile * _profile;
+
+    // bounded on-demand parsing
+    struct resident_func {
+        std::list<Function *>::iterator pos;
+        size_t bytes;
+    };
+    bool _on_demand;
+    bool _in_on_demand;
+    size_t _resident_budget;    // bytes; 0 is unbounded
+    size_t _resident_bytes;
+    std::list<Function *> _resident_lru;    // most recently used first
+    dyn_hash_map<Function *, resident_func> _resident;
+    std::map<Address, Function *> _entries; // all functions, by entry
+    std::set<Function *> _pinned;
+    size_t _evictions;
+
+    // calls out of functions reused from a previous CFG, linked once
+    // their targets have been parsed
+    struct reused_call {
+        Function * caller;
+        Block * src;
+        unsigned src_index;
+        Address target;
+        EdgeTypeEnum type;
+        FuncReturnStatus callee_rs;     // in the previous build
+    };
+    std::vector<reused_call> _reused_calls;
+    std::set<Function *> _prev_reused;  // still holding the reused CFG
+    size_t _prev_reparsed;              // reused, then parsed again
+    bool _from_cache;                   // CFG loaded from the cache
+
     enum ParseState {
         UNPARSED,       // raw state
         PARTIAL,        // parsing has started
@@ -138,6 +182,35 @@ class Parser {
     CFGFactory & factory() const { return _cfgfact; }
     CodeObject & obj() { return _obj; }
 
+    // the parser has started on the function at entry
+    void prefetch_advance(Address entry) {
+        if(_prefetch)
+            _prefetch->advance(entry);
+    }
+
+    // the instruction at addr, if it has been decoded ahead of parsing
+    InstructionAPI::Instruction::Ptr prefetched(Address addr) {
+        if(!_prefetch)
+            return InstructionAPI::Instruction::Ptr();
+        return _prefetch->take(addr);
+    }
+
+    JumpTableCache * jumptable_cache(Function * f);
+
+    ParseProfile * profile() const { return _profile; }
+    void set_profile(ParseProfile * p);
+
+    /* bounded on-demand parsing, implemented in Parser-ondemand.C */
+    void set_on_demand(bool on, size_t budget);
+    bool on_demand() const { return _on_demand; }
+    void pin_func(Function * f, bool pin);
+    size_t resident_bytes() const { return _resident_bytes; }
+
+    bool reused_previous(Function * f) const { return _prev_reused.count(f) != 0; }
+    size_t reused_previous() const { return _prev_reused.size(); }
+    size_t reparsed_previous() const { return _prev_reparsed; }
+    bool from_cache() const { return _from_cache; }
+
     // removal
     void remove_block(Block *);
     void remove_func(Function *);
@@ -154,6 +227,30 @@ class Parser {
 
  private:
     void parse_vanilla();
+    void start_prefetch(vector<ParseFrame *> const& work);
+
+    /* jump table analysis caches, implemented in Parser-jumptable.C */
+    void drop_jumptable_cache(Function * f);
+    void clear_jumptable_caches();
+
+    /* persistent CFG cache, implemented in Parser-cache.C */
+    bool cache_path(std::string & path);
+    bool load_cache();
+    void save_cache();
+    bool load_previous();
+    void link_previous();
+    bool reparse_reused(Function * f);
+    // parse f by itself if it is not parsed; f becomes most recently used
+    void on_demand_parse(Function * f);
+    // parse the functions that may contain addresses in [start,end)
+    void on_demand_parse(CodeRegion * cr, Address start, Address end);
+    bool parse_one(Function * f);
+    void touch(Function * f);
+    void forget_resident(Function * f);
+    void enforce_budget(unsigned keep);
+    bool evictable(Function * f);
+    void evict(Function * f);
+
     void parse_gap_heuristic(CodeRegion *cr);
     void probabilistic_gap_parsing(CodeRegion* cr);
     //void parse_sbp();
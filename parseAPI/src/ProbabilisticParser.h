@@ -52,6 +52,7 @@
 #include "CFG.h"
 
 #include "Instruction.h"
+#include "common/src/work_stealing_pool.h"
 
 using Dyninst::Address;
 using Dyninst::ParseAPI::CodeRegion;
@@ -109,6 +110,7 @@ struct Idiom {
 };
 
 class IdiomPrefixTree {
+    friend class IdiomAutomaton;
 public:
     typedef std::vector<std::pair<IdiomTerm, IdiomPrefixTree*> > ChildrenType;
     typedef dyn_hash_map<unsigned short, ChildrenType> ChildrenByEntryID;
@@ -131,6 +133,53 @@ public:
     const ChildrenType* getWildCardChildren();
 };
 
+/*
+ * An IdiomPrefixTree flattened into contiguous node and edge arrays.
+ * The edges leaving a node occupy one range, sorted by entry id (with
+ * insertion order kept among equal ids) so that the children for an
+ * opcode are found by binary search; wildcard children have their own
+ * range. Matching against the automaton visits children in the same
+ * order as the tree, so weights are summed identically.
+ */
+class IdiomAutomaton {
+public:
+    struct Node {
+        double w;
+        bool feature;
+        unsigned first;         // edges for specific entry ids
+        unsigned count;
+        unsigned wild_first;    // wildcard edges
+        unsigned wild_count;
+    };
+    struct Edge {
+        IdiomTerm term;
+        unsigned target;
+    };
+
+private:
+    std::vector<Node> nodes;
+    std::vector<Edge> edges;
+    unsigned max_depth;
+
+    unsigned flatten(IdiomPrefixTree *tree, unsigned depth);
+
+public:
+    IdiomAutomaton() : max_depth(0) {}
+    void build(IdiomPrefixTree *root);
+
+    const Node & node(unsigned n) const { return nodes[n]; }
+    const Edge & edge(unsigned e) const { return edges[e]; }
+    unsigned size() const { return nodes.size(); }
+    bool isLeaf(unsigned n) const {
+        return !nodes[n].count && !nodes[n].wild_count;
+    }
+    // Longest idiom in the tree, in instructions
+    unsigned depth() const { return max_depth; }
+    // The range of edges out of node n labelled with entry_id
+    void findEdges(unsigned n, unsigned short entry_id,
+                   unsigned &begin, unsigned &end) const;
+};
+
 class IdiomModel {
     IdiomPrefixTree normal;
     IdiomPrefixTree prefix;
@@ -141,8 +190,8 @@ class IdiomModel {
 
 public:
     IdiomModel(std::string model_spec);
-    double getBias() {return bias; }
-    double getProbThreshold() { return prob_threshold; }
+    double getBias() const {return bias; }
+    double getProbThreshold() const { return prob_threshold; }
     IdiomPrefixTree * getNormalIdiomTreeRoot() { return &normal; }
     IdiomPrefixTree * getPrefixIdiomTreeRoot() { return &prefix; }
 };
@@ -159,10 +208,40 @@ class ProbabilityCalculator {
         DecodeData() : entry_id(0), arg1(0), arg2(0), len(0) {}	    
     };
 
+    // Idiom extraction results for every byte of [base, base + data.size());
+    // a zero length marks an address that does not decode. Addresses
+    // outside of the window are decoded on demand.
+    struct DecodeWindow {
+        CodeRegion *cr;
+        Dyninst::Architecture arch;
+        Address base;
+        std::vector<DecodeData> data;
+        bool get(Address addr, DecodeData &ret) const;
+    };
+
+    // A range of gap addresses scored by one worker; results are
+    // stored at probs[addr - base]
+    struct ScoreChunk {
+        Address start;
+        Address end;
+        Address base;
+        std::vector<double> *probs;
+    };
+
     IdiomModel model;
     CodeRegion* cr;
     CodeSource* cs;
     Parser* parser;
+
+    IdiomAutomaton forward;
+    IdiomAutomaton backward;
+    WorkStealingPool<ScoreChunk> *pool;
+    // Gap addresses below this have been scored in bulk
+    Address scored_hi;
+    // Addresses of the region scored in bulk, by offset from its start.
+    // Only the scores of FEP candidates are kept in FEPProb; the others
+    // are known to be below the threshold.
+    std::vector<bool> scored;
     // The probability of each address to be FEP
     dyn_hash_map<Address, double> FEPProb;
     // The highest probability reaching to this address in enforcing overlapping constraints
@@ -188,22 +267,37 @@ class ProbabilityCalculator {
 				       dyn_hash_map<Address, double> &newReachingProb,
 				       dyn_hash_set<Function*> &newDiscoveredFuncs);
     bool decodeInstruction(DecodeData &data, Address addr);
+    static bool decodeAt(const unsigned char *buf, Dyninst::Architecture arch, DecodeData &data);
+
+    // Thread-safe counterparts of calc{Forward,Backward}Weights over
+    // the flattened idiom trees and a pre-decoded window
+    double matchForward(unsigned n, Address addr, const DecodeWindow &win, bool &valid) const;
+    double matchBackward(unsigned n, Address addr, const DecodeWindow &win,
+                         std::vector<unsigned> &seen, unsigned epoch) const;
+    double scoreAt(Address addr, const DecodeWindow &win,
+                   std::vector<unsigned> &seen, unsigned epoch) const;
+    void scoreChunk(ScoreChunk &chunk);
 
     void Finalize(dyn_hash_map<Address, double> &newFEPProb,
                   dyn_hash_map<Address, double> &newReachingProb,
 		  dyn_hash_set<Function*> &newDiscoveredFuncs);
     void Remove(dyn_hash_set<Function*> &newDiscoveredFuncs);
     double getReachingProb(Address addr);
+    bool isScored(Address addr) const;
    
 
 public:
-    ProbabilityCalculator(CodeRegion *reg, CodeSource *source, Parser *parser, std::string model_spec);
+    ProbabilityCalculator(CodeRegion *reg, CodeSource *source, Parser *parser, std::string model_spec,
+                          unsigned nthreads = 1);
 	virtual ~ProbabilityCalculator() {
 		FEPProb.clear();
 	    reachingProb.clear();
 		finalized.clear();
+		delete pool;
 	}
     double calcProbByMatchingIdioms(Address addr);
+    // Score every address of [start, end) at once, in parallel chunks
+    void calcProbByMatchingIdioms(Address start, Address end);
     void calcProbByEnforcingConstraints();
     double getFEPProb(Address addr);
     bool isFEP(Address addr);
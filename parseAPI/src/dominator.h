@@ -33,67 +33,90 @@
 
 #include "dyntypes.h"
 #include "CFG.h"
-#include <unordered_map>
 #include <set>
-
-using namespace std;
+#include <vector>
 
 namespace Dyninst{
 namespace ParseAPI{
 
-class dominatorCFG;
-class dominatorBB;
-
-class dominatorBB {
+/*
+ * The (post-)dominator tree of a function over densely numbered blocks.
+ * Block i of the tree is the i'th block of the function in address
+ * order. The children of block i occupy child[child_first[i] ..
+ * child_first[i+1]), and a preorder walk of the tree assigns each block
+ * the interval [pre[i], last[i]] spanning its subtree, so that
+ * dominance is an interval containment test.
+ */
+class dominatorTree {
    friend class dominatorCFG;
-protected:
-   int dfs_no;
-   int size;
-   dominatorBB *semiDom;
-   dominatorBB *immDom;
-   dominatorBB *label;
-   dominatorBB *ancestor;
-   dominatorBB *parent;
-   dominatorBB *child;
+ public:
+   static const unsigned NONE = (unsigned) -1;
 
-   Block *parseBlock;
-   dominatorCFG *dom_cfg;
+ private:
+   std::vector<Block *> blocks;
+   dyn_hash_map<const Block *, unsigned> block_index;
+   std::vector<unsigned> idom;
+   std::vector<unsigned> child_first;
+   std::vector<unsigned> child;
+   std::vector<unsigned> pre;
+   std::vector<unsigned> last;
+   std::vector<unsigned> order;      // preorder number -> block
+
+   void number();
 
-   std::set<dominatorBB *> bucket;
-   vector<dominatorBB *> pred;
-   vector<dominatorBB *> succ;   
  public:
-   dominatorBB(Block *bb, dominatorCFG *dc);
-   ~dominatorBB();
-   dominatorBB *eval();
-   void compress();
-   int sdno();
+   // Dense number of b, or NONE if b is not in the function
+   unsigned index(const Block *b) const;
+   Block *block(unsigned i) const { return blocks[i]; }
+
+   bool dominates(const Block *a, const Block *b) const;
+   Block *immediateDominator(const Block *b) const;
+   void immediateDominates(const Block *a, std::set<Block *> &out) const;
+   void allDominates(const Block *a, std::set<Block *> &out) const;
 };
 
+/*
+ * Computes dominator trees with the Lengauer-Tarjan algorithm. Node 0
+ * is a virtual entry that reaches the function entry and any block
+ * without sources (for post-dominators, the exit blocks and any block
+ * without targets); block i of the function is node i+1. Edges are
+ * kept in compressed rows and all per-node state in flat arrays.
+ */
 class dominatorCFG {
-   friend class dominatorBB;
  protected:
-   std::unordered_map<Address, dominatorBB *> map_;
    const Function *func;
-   vector<dominatorBB *> all_blocks;
-   vector<dominatorBB *> sorted_blocks;
-   int currentDepthNo;
+   std::vector<Block *> blocks;
+   dyn_hash_map<const Block *, unsigned> block_index;
+
+   std::vector<unsigned> succ_first;
+   std::vector<unsigned> succ;
+   std::vector<unsigned> pred_first;
+   std::vector<unsigned> pred;
 
-   dominatorBB *entryBlock;
-   dominatorBB *nullNode;
+   std::vector<unsigned> dfs_no;     // node -> preorder number
+   std::vector<unsigned> vertex;     // preorder number -> node
+   std::vector<unsigned> parent;
+   std::vector<unsigned> semi;       // as a preorder number
+   std::vector<unsigned> idom;
+   std::vector<unsigned> ancestor;
+   std::vector<unsigned> label;
+   std::vector<unsigned> bucket_head;
+   std::vector<unsigned> bucket_next;
+   std::vector<unsigned> path;
 
+   unsigned findNode(const Block *b) const;
+   void buildGraph(bool reverse);
+   void depthFirstSearch();
    void performComputation();
-   void depthFirstSearch(dominatorBB *v);
-   void eval(dominatorBB *v);
-   void link(dominatorBB *v, dominatorBB *w);
-   dominatorBB *parseToDomBB(Block *bb);
+   unsigned eval(unsigned v);
+   void compress(unsigned v);
+   dominatorTree *makeTree() const;
 
  public:
    dominatorCFG(const Function *f);
-   ~dominatorCFG();
 
-   void calcDominators();
-   void calcPostDominators();
+   dominatorTree *calcDominators();
+   dominatorTree *calcPostDominators();
 };
 }
 }
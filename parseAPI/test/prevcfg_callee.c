@@ -0,0 +1,33 @@
+/*
+ * The callees edited between the two builds of the prevcfg test program.
+ * In the new build c() still returns but computes something else, so
+ * b(), a() and main(), which are unchanged, are reused from the previous
+ * build's CFG. d() no longer returns, so e() is reused and then parsed
+ * again to pick up its callee's new return status. Both builds call
+ * exit() so that their PLTs, and the addresses of the functions in
+ * prevcfg_main.c, are the same.
+ */
+
+#include <stdlib.h>
+
+volatile int sink;
+
+__attribute__((noinline)) void c(int x)
+{
+#if defined(EDITED)
+    sink += x * 7;
+#else
+    sink += x;
+#endif
+}
+
+__attribute__((noinline)) void d(int x)
+{
+#if defined(EDITED)
+    exit(x);
+#else
+    if (x < 0)
+        exit(-x);
+    sink -= x;
+#endif
+}
@@ -0,0 +1,30 @@
+/*
+ * Program parsed by the prevcfg test. Its two builds differ only in
+ * prevcfg_callee.c; the functions here are the same code in both.
+ */
+
+extern void c(int x);
+extern void d(int x);
+
+__attribute__((noinline)) int b(int x)
+{
+    c(x);
+    return x * 3;
+}
+
+__attribute__((noinline)) int a(int x)
+{
+    return b(x) + 5;
+}
+
+__attribute__((noinline, used)) int e(int x)
+{
+    d(x);
+    return x - 1;
+}
+
+int main(int argc, char * argv[])
+{
+    (void) argv;
+    return a(argc);
+}
@@ -0,0 +1,53 @@
+/*
+ * Program analyzed by the stacksummaries test: the call chain top() ->
+ * mid() -> leaf(), and the mutually recursive even() and odd(), which
+ * top() also calls. Each call's result is used after it returns, so none
+ * of them becomes a tail call.
+ */
+
+volatile int sink;
+
+__attribute__((noinline)) int leaf(int x)
+{
+    volatile int buf[16];
+    buf[x & 15] = x;
+    return buf[(x + 1) & 15];
+}
+
+__attribute__((noinline)) int mid(int x)
+{
+    int r = leaf(x);
+    return r + leaf(x + 1);
+}
+
+__attribute__((noinline)) int odd(int x);
+
+__attribute__((noinline)) int even(int x)
+{
+    if (x == 0)
+        return 1;
+    int r = odd(x - 1);
+    sink += r;
+    return r;
+}
+
+__attribute__((noinline)) int odd(int x)
+{
+    if (x == 0)
+        return 0;
+    int r = even(x - 1);
+    sink += r;
+    return r;
+}
+
+__attribute__((noinline)) int top(int x)
+{
+    int r = mid(x);
+    return r + even(x & 7);
+}
+
+int main(int argc, char * argv[])
+{
+    (void) argv;
+    return top(argc);
+}